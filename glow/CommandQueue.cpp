@@ -0,0 +1,337 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "CommandQueue.h"
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+#include "FrameBuffer.h"
+#include "VertexBuffer.h"
+#include "Texture.h"
+#include "Sampler.h"
+#include "UniformBuffer.h"
+#include "util.h"
+
+namespace glow
+{
+    void CommandRecorder::draw(const DrawPacket& packet, std::span<const TextureBinding> tex, std::span<const BufferBinding> buf, std::span<const UniformBinding> uni) noexcept
+    {
+        GLOW_ASSERT(packet.shader != nullptr);
+        GLOW_ASSERT(packet.buffer != nullptr);
+
+        auto p = Packet{};
+        p.draw          = packet;
+        p.first_texture = static_cast<std::uint32_t>(textures.size());
+        p.texture_count = static_cast<std::uint32_t>(tex.size());
+        p.first_buffer  = static_cast<std::uint32_t>(buffers.size());
+        p.buffer_count  = static_cast<std::uint32_t>(buf.size());
+        p.first_uniform = static_cast<std::uint32_t>(uniforms.size());
+        p.uniform_count = static_cast<std::uint32_t>(uni.size());
+
+        textures.insert(end(textures), begin(tex), end(tex));
+        buffers.insert(end(buffers), begin(buf), end(buf));
+        uniforms.insert(end(uniforms), begin(uni), end(uni));
+        packets.push_back(p);
+    }
+
+    size_t CommandRecorder::get_packet_count() const noexcept
+    {
+        return packets.size();
+    }
+
+    void CommandRecorder::clear() noexcept
+    {
+        packets.clear();
+        textures.clear();
+        buffers.clear();
+        uniforms.clear();
+    }
+
+    // The top 20 bits of a positive float keep their order.
+    std::uint64_t depth_bits(float depth) noexcept
+    {
+        if (!(depth > 0.0f))
+        {
+            return 0u;
+        }
+        return std::bit_cast<std::uint32_t>(depth) >> 12u;
+    }
+
+    // pass (8) | target (8) | program (12) | material (16) | depth (20)
+    // pass (8) | target (8) | inverted depth (20) | program (12) | material (16)
+    std::uint64_t sort_key(const DrawPacket& packet, std::uint8_t target, glm::uint program) noexcept
+    {
+        const auto pass     = static_cast<std::uint64_t>(packet.pass);
+        const auto fbo      = static_cast<std::uint64_t>(target);
+        const auto shader   = static_cast<std::uint64_t>(program & 0xFFFu);
+        const auto material = static_cast<std::uint64_t>(packet.material & 0xFFFFu);
+        const auto depth    = depth_bits(packet.depth);
+
+        if (packet.back_to_front)
+        {
+            return (pass << 56u) | (fbo << 48u) | ((0xFFFFFu - depth) << 28u) | (shader << 16u) | material;
+        }
+        return (pass << 56u) | (fbo << 48u) | (shader << 36u) | (material << 20u) | depth;
+    }
+
+    CommandQueue::CommandQueue() noexcept = default;
+
+    CommandQueue::~CommandQueue() = default;
+
+    CommandRecorder& CommandQueue::get_recorder() noexcept
+    {
+        const auto id = std::this_thread::get_id();
+
+        auto lock = std::scoped_lock{mutex};
+        for (auto& [thread, recorder] : recorders)
+        {
+            if (thread == id)
+            {
+                return *recorder;
+            }
+        }
+        recorders.emplace_back(id, std::make_unique<CommandRecorder>());
+        return *recorders.back().second;
+    }
+
+    void CommandQueue::submit() noexcept
+    {
+        GLOW_DEBUG_GROUP("CommandQueue::submit");
+
+        auto lock = std::scoped_lock{mutex};
+        merge();
+        sort();
+        replay();
+
+        for (auto& [thread, recorder] : recorders)
+        {
+            recorder->clear();
+        }
+        entries.clear();
+    }
+
+    void CommandQueue::clear() noexcept
+    {
+        auto lock = std::scoped_lock{mutex};
+        for (auto& [thread, recorder] : recorders)
+        {
+            recorder->clear();
+        }
+        entries.clear();
+    }
+
+    size_t CommandQueue::get_draw_count() const noexcept
+    {
+        return draw_count;
+    }
+
+    size_t CommandQueue::get_state_changes() const noexcept
+    {
+        return state_changes;
+    }
+
+    void CommandQueue::merge() noexcept
+    {
+        entries.clear();
+
+        // frame buffers are numbered in the order they are first seen,
+        // the default frame buffer is drawn last
+        auto targets = std::vector<FrameBuffer*>{};
+        auto get_target_index = [&] (FrameBuffer* target) -> std::uint8_t {
+            if (target == nullptr)
+            {
+                return 0xFFu;
+            }
+            auto i = std::find(begin(targets), end(targets), target);
+            if (i == end(targets))
+            {
+                i = targets.insert(i, target);
+            }
+            // past 255 targets draws are still correct, but may switch targets more often
+            return static_cast<std::uint8_t>(std::min<size_t>(std::distance(begin(targets), i), 0xFEu));
+        };
+
+        for (auto r = 0u; r < recorders.size(); r++)
+        {
+            const auto& packets = recorders[r].second->packets;
+            for (auto p = 0u; p < packets.size(); p++)
+            {
+                const auto& draw = packets[p].draw;
+                entries.push_back({sort_key(draw, get_target_index(draw.target), draw.shader->program_id), r, p});
+            }
+        }
+    }
+
+    void CommandQueue::sort() noexcept
+    {
+        // LSD radix sort, one byte per pass; stable, so equal keys keep recording order.
+        scratch.resize(entries.size());
+        for (auto shift = 0u; shift < 64u; shift += 8u)
+        {
+            auto counts = std::array<size_t, 256>{};
+            for (const auto& entry : entries)
+            {
+                counts[(entry.key >> shift) & 0xFFu]++;
+            }
+
+            // all keys share this byte, nothing to do
+            if (counts[(entries.empty() ? 0u : (entries.front().key >> shift) & 0xFFu)] == entries.size())
+            {
+                continue;
+            }
+
+            auto offset = size_t{0};
+            for (auto& count : counts)
+            {
+                const auto c = count;
+                count  = offset;
+                offset += c;
+            }
+
+            for (const auto& entry : entries)
+            {
+                scratch[counts[(entry.key >> shift) & 0xFFu]++] = entry;
+            }
+            std::swap(entries, scratch);
+        }
+    }
+
+    void CommandQueue::replay() noexcept
+    {
+        draw_count    = 0u;
+        state_changes = 0u;
+        if (entries.empty())
+        {
+            return;
+        }
+
+        auto target   = static_cast<FrameBuffer*>(nullptr);
+        auto shader   = static_cast<Shader*>(nullptr);
+        auto buffer   = static_cast<VertexBuffer*>(nullptr);
+        auto textures = std::vector<std::pair<Texture*, const Sampler*>>{};
+        auto ubos     = std::vector<UniformBuffer*>{};
+
+        for (const auto& entry : entries)
+        {
+            const auto& recorder = *recorders[entry.recorder].second;
+            const auto& packet   = recorder.packets[entry.packet];
+            const auto& draw     = packet.draw;
+
+            if (draw.target != target)
+            {
+                if (target != nullptr)
+                {
+                    target->unbind();
+                }
+                if (draw.target != nullptr)
+                {
+                    draw.target->bind();
+                }
+                target = draw.target;
+                state_changes++;
+            }
+
+            if (draw.shader != shader)
+            {
+                draw.shader->bind();
+                shader = draw.shader;
+                buffer = nullptr;
+                state_changes++;
+            }
+
+            if (draw.buffer != buffer)
+            {
+                draw.buffer->bind(*shader);
+                buffer = draw.buffer;
+                state_changes++;
+            }
+
+            for (auto i = 0u; i < packet.texture_count; i++)
+            {
+                const auto& tb = recorder.textures[packet.first_texture + i];
+                GLOW_ASSERT(tb.texture != nullptr);
+                if (tb.slot >= textures.size())
+                {
+                    textures.resize(tb.slot + 1u, {nullptr, nullptr});
+                }
+
+                auto& [texture, sampler] = textures[tb.slot];
+                if (texture == tb.texture && sampler == tb.sampler)
+                {
+                    continue;
+                }
+
+                if (tb.sampler != nullptr)
+                {
+                    tb.texture->bind(tb.slot, *tb.sampler);
+                }
+                else
+                {
+                    tb.texture->bind(tb.slot);
+                }
+                texture = tb.texture;
+                sampler = tb.sampler;
+                state_changes++;
+            }
+
+            for (auto i = 0u; i < packet.buffer_count; i++)
+            {
+                const auto& bb = recorder.buffers[packet.first_buffer + i];
+                GLOW_ASSERT(bb.buffer != nullptr);
+                if (bb.binding >= ubos.size())
+                {
+                    ubos.resize(bb.binding + 1u, nullptr);
+                }
+
+                if (ubos[bb.binding] != bb.buffer)
+                {
+                    bb.buffer->bind(bb.binding);
+                    ubos[bb.binding] = bb.buffer;
+                    state_changes++;
+                }
+            }
+
+            for (auto i = 0u; i < packet.uniform_count; i++)
+            {
+                const auto& ub = recorder.uniforms[packet.first_uniform + i];
+                shader->set_uniform(ub.handle, ub.value);
+            }
+
+            if (draw.instance_count == 0u)
+            {
+                buffer->draw(draw.set);
+            }
+            else
+            {
+                buffer->draw_instanced(draw.set, draw.instance_count, draw.base_instance);
+            }
+            draw_count++;
+        }
+
+        if (target != nullptr)
+        {
+            target->unbind();
+        }
+    }
+}
@@ -0,0 +1,213 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "defines.h"
+#include "Shader.h"
+
+namespace glow
+{
+    class FrameBuffer;
+    class VertexBuffer;
+    class Texture;
+    class Sampler;
+    class UniformBuffer;
+
+    //! Texture bound for a draw packet.
+    //!
+    //! The shader's sampler must use the slot, either through
+    //! layout(binding) or by setting the uniform once.
+    struct TextureBinding
+    {
+        unsigned int   slot    = 0u;
+        Texture*       texture = nullptr;
+        const Sampler* sampler = nullptr;
+    };
+
+    //! Uniform or storage buffer bound for a draw packet.
+    struct BufferBinding
+    {
+        unsigned int   binding = 0u;
+        UniformBuffer* buffer  = nullptr;
+    };
+
+    //! Uniform value set for a draw packet.
+    struct UniformBinding
+    {
+        UniformHandle handle;
+        UniformValue  value;
+    };
+
+    //! Draw Packet
+    //!
+    //! A draw recorded into a command queue.
+    struct DrawPacket
+    {
+        //! The pass, passes are drawn in ascending order.
+        std::uint8_t  pass           = 0u;
+        //! The frame buffer to draw into, nullptr for the default frame buffer.
+        FrameBuffer*  target         = nullptr;
+        //! The shader to draw with.
+        Shader*       shader         = nullptr;
+        //! The vertex buffer to draw.
+        VertexBuffer* buffer         = nullptr;
+        //! The index set of the vertex buffer.
+        unsigned int  set            = 0u;
+        //! The number of instances, 0 draws without instancing.
+        unsigned int  instance_count = 0u;
+        //! The first instance of the per instance values.
+        unsigned int  base_instance  = 0u;
+        //! Application defined material, draws of a material are grouped.
+        //! Only the low 16 bits are used for sorting.
+        std::uint32_t material       = 0u;
+        //! The view depth, draws are sorted front to back.
+        float         depth          = 0.0f;
+        //! Sort back to front before shader and material, for blending.
+        bool          back_to_front  = false;
+    };
+
+    //! Command Recorder
+    //!
+    //! Records draw packets of one thread, see CommandQueue.
+    class GLOW_EXPORT CommandRecorder
+    {
+    public:
+        //! Create an empty recorder.
+        CommandRecorder() noexcept = default;
+
+        //! Record a draw.
+        //!
+        //! The bindings are copied.
+        //!
+        //! @param packet the draw
+        //! @param textures the textures to bind
+        //! @param buffers the uniform and storage buffers to bind
+        //! @param uniforms the uniform values to set
+        void draw(const DrawPacket& packet, std::span<const TextureBinding> textures = {}, std::span<const BufferBinding> buffers = {}, std::span<const UniformBinding> uniforms = {}) noexcept;
+
+        //! Get the number of recorded draws.
+        size_t get_packet_count() const noexcept;
+
+        //! Remove all recorded draws.
+        void clear() noexcept;
+
+    private:
+        struct Packet
+        {
+            DrawPacket    draw;
+            std::uint32_t first_texture = 0u;
+            std::uint32_t texture_count = 0u;
+            std::uint32_t first_buffer  = 0u;
+            std::uint32_t buffer_count  = 0u;
+            std::uint32_t first_uniform = 0u;
+            std::uint32_t uniform_count = 0u;
+        };
+
+        std::vector<Packet>         packets;
+        std::vector<TextureBinding> textures;
+        std::vector<BufferBinding>  buffers;
+        std::vector<UniformBinding> uniforms;
+
+        CommandRecorder(const CommandRecorder&) = delete;
+        CommandRecorder& operator = (const CommandRecorder&) = delete;
+
+    friend class CommandQueue;
+    };
+
+    //! Command Queue
+    //!
+    //! The command queue records draws instead of executing them and
+    //! draws them in an order that minimizes state changes on submit.
+    //!
+    //! Each thread records into its own CommandRecorder, obtained with
+    //! get_recorder, without any locking. Only submit touches OpenGL and
+    //! must be called on the context's thread after all recording
+    //! finished.
+    //!
+    //! On submit the draws of all recorders are merged and radix sorted
+    //! by a 64 bit key of pass, target, program, material and depth.
+    //! Within a pass the frame buffers are drawn in the order they first
+    //! appear in the recorders, the default frame buffer last. Replaying
+    //! them only binds what differs from the previous draw. Draws with
+    //! back_to_front set are ordered by depth before program and material
+    //! and should use a pass of their own.
+    class GLOW_EXPORT CommandQueue
+    {
+    public:
+        //! Create an empty command queue.
+        CommandQueue() noexcept;
+
+        //! Release command queue.
+        ~CommandQueue();
+
+        //! Get the recorder of the calling thread.
+        //!
+        //! This function is thread safe, the recorder may be kept for
+        //! the lifetime of the queue.
+        CommandRecorder& get_recorder() noexcept;
+
+        //! Sort and draw all recorded draws and clear the recorders.
+        //!
+        //! The default frame buffer must be bound, it is bound again
+        //! after the last draw.
+        void submit() noexcept;
+
+        //! Remove all recorded draws.
+        void clear() noexcept;
+
+        //! Get the number of draws of the last submit.
+        size_t get_draw_count() const noexcept;
+
+        //! Get the number of state changes of the last submit.
+        size_t get_state_changes() const noexcept;
+
+    private:
+        struct Entry
+        {
+            std::uint64_t key      = 0u;
+            std::uint32_t recorder = 0u;
+            std::uint32_t packet   = 0u;
+        };
+
+        std::mutex                 mutex;
+        std::vector<std::pair<std::thread::id, std::unique_ptr<CommandRecorder>>> recorders;
+        std::vector<Entry>         entries;
+        std::vector<Entry>         scratch;
+        size_t                     draw_count    = 0u;
+        size_t                     state_changes = 0u;
+
+        void merge() noexcept;
+        void sort() noexcept;
+        void replay() noexcept;
+
+        CommandQueue(const CommandQueue&) = delete;
+        CommandQueue& operator = (const CommandQueue&) = delete;
+    };
+}
@@ -0,0 +1,105 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "DrawBatch.h"
+#include "util.h"
+
+namespace glow
+{
+    DrawBatch::DrawBatch() noexcept
+    {
+        glGenBuffers(1, &glid);
+        GLOW_CHECK_GLERROR();
+    }
+
+    DrawBatch::~DrawBatch()
+    {
+        glDeleteBuffers(1, &glid);
+        glid = 0;
+        GLOW_CHECK_GLERROR();
+    }
+
+    void DrawBatch::add(const MeshRange& mesh, unsigned int instance_count) noexcept
+    {
+        add(mesh, instance_count, instances);
+    }
+
+    void DrawBatch::add(const MeshRange& mesh, unsigned int instance_count, unsigned int base_instance) noexcept
+    {
+        GLOW_ASSERT(mesh.is_valid());
+
+        commands.push_back({mesh.index_count, instance_count, mesh.first_index, mesh.base_vertex, base_instance});
+        instances = std::max(instances, base_instance + instance_count);
+        dirty     = true;
+    }
+
+    void DrawBatch::clear() noexcept
+    {
+        commands.clear();
+        instances = 0u;
+        dirty     = true;
+    }
+
+    size_t DrawBatch::get_draw_count() const noexcept
+    {
+        return commands.size();
+    }
+
+    unsigned int DrawBatch::get_instance_count() const noexcept
+    {
+        return instances;
+    }
+
+    void DrawBatch::draw(MeshPool& pool) noexcept
+    {
+        GLOW_DEBUG_GROUP("DrawBatch::draw");
+        GLOW_ASSERT(glid != 0);
+
+        if (commands.empty())
+        {
+            return;
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, glid);
+
+        if (dirty)
+        {
+            auto size = commands.size() * sizeof(DrawCommand);
+            if (size > capacity)
+            {
+                glBufferData(GL_DRAW_INDIRECT_BUFFER, size, commands.data(), GL_DYNAMIC_DRAW);
+                capacity = size;
+            }
+            else
+            {
+                glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, size, commands.data());
+            }
+            dirty = false;
+        }
+
+        glMultiDrawElementsIndirect(get_gl_facetype(pool.get_faces_type()), GL_UNSIGNED_INT, nullptr,
+                                    static_cast<GLsizei>(commands.size()), 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+        GLOW_CHECK_GLERROR();
+    }
+}
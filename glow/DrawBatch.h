@@ -0,0 +1,101 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <vector>
+
+#include "defines.h"
+#include "MeshPool.h"
+
+namespace glow
+{
+    //! Draw Batch
+    //!
+    //! The draw batch collects draws of meshes from one mesh pool and
+    //! submits them with a single glMultiDrawElementsIndirect. The
+    //! commands are only uploaded when they changed, so a batch of static
+    //! objects costs one call per frame.
+    //!
+    //! Typically there is one batch per material, all objects with the
+    //! same shader and textures are drawn together.
+    class GLOW_EXPORT DrawBatch
+    {
+    public:
+        //! Create an empty draw batch.
+        DrawBatch() noexcept;
+
+        //! Release draw batch.
+        ~DrawBatch();
+
+        //! Add a draw.
+        //!
+        //! The draw gets the instances following those of the previous
+        //! draw, so that per instance values can be used as per object data.
+        //!
+        //! @param mesh the mesh to draw
+        //! @param instance_count the number of instances to draw
+        void add(const MeshRange& mesh, unsigned int instance_count = 1u) noexcept;
+
+        //! Add a draw with explicit base instance.
+        //!
+        //! @param mesh the mesh to draw
+        //! @param instance_count the number of instances to draw
+        //! @param base_instance the first instance of the per instance values
+        void add(const MeshRange& mesh, unsigned int instance_count, unsigned int base_instance) noexcept;
+
+        //! Remove all draws.
+        void clear() noexcept;
+
+        //! Get the number of draws.
+        size_t get_draw_count() const noexcept;
+
+        //! Get the number of instances used by add.
+        unsigned int get_instance_count() const noexcept;
+
+        //! Draw all meshes.
+        //!
+        //! @param pool the pool the meshes belong to, must be bound
+        void draw(MeshPool& pool) noexcept;
+
+    private:
+        // layout defined by glMultiDrawElementsIndirect
+        struct DrawCommand
+        {
+            unsigned int count;
+            unsigned int instance_count;
+            unsigned int first_index;
+            int          base_vertex;
+            unsigned int base_instance;
+        };
+
+        static_assert(sizeof(DrawCommand) == 20u);
+
+        std::vector<DrawCommand> commands;
+        unsigned int             instances = 0u;
+        unsigned int             glid      = 0u;
+        size_t                   capacity  = 0u;
+        bool                     dirty     = false;
+
+        DrawBatch(const DrawBatch&) = delete;
+        DrawBatch& operator = (const DrawBatch&) = delete;
+    };
+}
@@ -21,6 +21,7 @@
 
 #include "pch.h"
 #include "FrameBuffer.h"
+#include "StateCache.h"
 #include "util.h"
 
 namespace glow
@@ -47,9 +48,16 @@ namespace glow
     FrameBuffer::FrameBuffer()
     : bound(false), glid(0)
     {
-        glGenFramebuffers(1, &glid);
+        if (has_direct_state_access())
+        {
+            glCreateFramebuffers(1, &glid);
+        }
+        else
+        {
+            glGenFramebuffers(1, &glid);
+        }
 
-        assert(glGetError() == GL_NO_ERROR);
+        GLOW_CHECK_GLERROR();
     }
 
 
@@ -58,8 +66,9 @@ namespace glow
         if (glid != 0)
         {
             glDeleteFramebuffers(1, &glid);
+            StateCache::get().release_framebuffer(glid);
 
-            assert(glGetError() == GL_NO_ERROR);
+            GLOW_CHECK_GLERROR();
         }
     }
 
@@ -67,53 +76,143 @@ namespace glow
     {
         assert(glid != 0);
 
-        glBindFramebuffer(GL_FRAMEBUFFER, glid);
+        StateCache::get().bind_framebuffer(GL_FRAMEBUFFER, glid);
         bound = true;
 
-        assert(glGetError() == GL_NO_ERROR);
+        GLOW_CHECK_GLERROR();
     }
 
     void FrameBuffer::unbind()
     {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        StateCache::get().bind_framebuffer(GL_FRAMEBUFFER, 0);
         bound = false;
 
-        assert(glGetError() == GL_NO_ERROR);
+        GLOW_CHECK_GLERROR();
     }
 
     void FrameBuffer::attach_depth(Texture& texture)
     {
         assert(glid != 0);
-        assert(bound);
+        assert(bound || has_direct_state_access());
+
+        if (has_direct_state_access())
+        {
+            glNamedFramebufferTexture(glid, GL_DEPTH_ATTACHMENT, texture.glid, 0);
+        }
+        else if (texture.type == TextureType::TEXTURE2D)
+        {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, texture.glid, 0);
+        }
+        else
+        {
+            glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture.glid, 0);
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void FrameBuffer::attach_depth(Texture& texture, unsigned int layer)
+    {
+        assert(glid != 0);
+        assert(bound || has_direct_state_access());
+        assert(texture.type == TextureType::TEXTURE2D_ARRAY || texture.type == TextureType::TEXTURE3D || texture.type == TextureType::CUBE_MAP_ARRAY);
 
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, texture.glid, 0);
+        if (has_direct_state_access())
+        {
+            glNamedFramebufferTextureLayer(glid, GL_DEPTH_ATTACHMENT, texture.glid, 0, layer);
+        }
+        else
+        {
+            glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture.glid, 0, layer);
+        }
 
-        assert(glGetError() == GL_NO_ERROR);
+        GLOW_CHECK_GLERROR();
     }
 
     void FrameBuffer::attach(unsigned int slot, Texture& texture, unsigned int level)
     {
         assert(glid != 0);
-        assert(bound);
+        assert(bound || has_direct_state_access());
+        assert(slot < 15);
+
+        if (has_direct_state_access())
+        {
+            glNamedFramebufferTexture(glid, GL_COLOR_ATTACHMENT0 + slot, texture.glid, level);
+        }
+        else if (texture.type == TextureType::TEXTURE2D)
+        {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + slot, GL_TEXTURE_2D, texture.glid, level);
+        }
+        else
+        {
+            glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + slot, texture.glid, level);
+        }
+        glNamedFramebufferDrawBuffers(glid, slot + 1, buffers);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void FrameBuffer::attach_layer(unsigned int slot, Texture& texture, unsigned int layer, unsigned int level)
+    {
+        assert(glid != 0);
+        assert(bound || has_direct_state_access());
         assert(slot < 15);
+        assert(texture.type == TextureType::TEXTURE2D_ARRAY || texture.type == TextureType::TEXTURE3D || texture.type == TextureType::CUBE_MAP_ARRAY);
 
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + slot, GL_TEXTURE_2D, texture.glid, level);
+        if (has_direct_state_access())
+        {
+            glNamedFramebufferTextureLayer(glid, GL_COLOR_ATTACHMENT0 + slot, texture.glid, level, layer);
+        }
+        else
+        {
+            glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + slot, texture.glid, level, layer);
+        }
         glNamedFramebufferDrawBuffers(glid, slot + 1, buffers);
 
-        assert(glGetError() == GL_NO_ERROR);
+        GLOW_CHECK_GLERROR();
     }
 
     void FrameBuffer::attach(unsigned int slot, Texture& texture, CubeFace face, unsigned int level)
     {
         assert(glid != 0);
-        assert(bound);
+        assert(bound || has_direct_state_access());
         assert(slot < 15);
 
-        GLenum target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(face);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + slot, target, texture.glid, level);
+        if (has_direct_state_access())
+        {
+            // the faces of a cube map are layers
+            glNamedFramebufferTextureLayer(glid, GL_COLOR_ATTACHMENT0 + slot, texture.glid, level, static_cast<GLint>(face));
+        }
+        else
+        {
+            GLenum target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(face);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + slot, target, texture.glid, level);
+        }
 
         glNamedFramebufferDrawBuffers(glid, slot + 1, buffers);
 
-        assert(glGetError() == GL_NO_ERROR);
+        GLOW_CHECK_GLERROR();
+    }
+
+    std::vector<std::byte> FrameBuffer::read_pixels(unsigned int slot, glm::uvec2 offset, glm::uvec2 size, ColorMode color, DataType data)
+    {
+        GLOW_DEBUG_GROUP("FrameBuffer::read_pixels");
+        auto result = std::vector<std::byte>(size_t{size.x} * size.y * get_pixel_size(color, data));
+        read_region(slot, offset, size, color, data, result.data());
+        return result;
+    }
+
+    void FrameBuffer::read_region(unsigned int slot, glm::uvec2 offset, glm::uvec2 size, ColorMode color, DataType data, void* bits)
+    {
+        assert(glid != 0);
+        assert(slot < 15);
+
+        StateCache::get().bind_framebuffer(GL_READ_FRAMEBUFFER, glid);
+        glReadBuffer(GL_COLOR_ATTACHMENT0 + slot);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(offset.x, offset.y, size.x, size.y, get_gl_format(color), get_gl_type(data), bits);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+        GLOW_CHECK_GLERROR();
     }
 }
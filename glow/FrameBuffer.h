@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "defines.h"
 
 #include "Texture.h"
@@ -46,15 +48,37 @@ namespace glow
         void unbind();
 
         //! Attach depth buffer.
+        //!
+        //! Array, 3D and cube map textures are attached layered, the
+        //! layer is selected with gl_Layer in the geometry shader.
         void attach_depth(Texture& texture);
 
+        //! Attach a layer as depth buffer.
+        //!
+        //! @param texture the array, 3D or cube map array texture
+        //! @param layer the layer to write to
+        void attach_depth(Texture& texture, unsigned int layer);
+
         //! Attach color buffer.
         //!
+        //! Array, 3D and cube map textures are attached layered, the
+        //! layer is selected with gl_Layer in the geometry shader.
+        //!
         //! @param slot the slot to use
         //! @param texture the texture to write to
         //! @param level the mipmap level to write to
         void attach(unsigned int slot, Texture& texture, unsigned int level = 0);
 
+        //! Attach a layer as color buffer.
+        //!
+        //! For cube map arrays the layer is cube * 6 + face.
+        //!
+        //! @param slot the slot to use
+        //! @param texture the array, 3D or cube map array texture
+        //! @param layer the layer to write to
+        //! @param level the mipmap level to write to
+        void attach_layer(unsigned int slot, Texture& texture, unsigned int layer, unsigned int level = 0);
+
         //! Attach cubamap face as color buffer.
         //!
         //! @param slot the slot to use
@@ -63,6 +87,19 @@ namespace glow
         //! @param level the mipmap level to write to
         void attach(unsigned int slot, Texture& texture, CubeFace face, unsigned int level = 0);
 
+        //! Read pixels from a color buffer.
+        //!
+        //! This blocks until the GPU finished rendering, use PixelReader
+        //! to read without stalling.
+        //!
+        //! @param slot the color buffer slot
+        //! @param offset the offset of the region in pixels
+        //! @param size the size of the region in pixels
+        //! @param color the color mode to read
+        //! @param data the data type to read
+        //! @return the pixels with tightly packed rows
+        std::vector<std::byte> read_pixels(unsigned int slot, glm::uvec2 offset, glm::uvec2 size, ColorMode color, DataType data);
+
     private:
         bool         bound;
         unsigned int glid;
@@ -70,5 +107,8 @@ namespace glow
         FrameBuffer(const FrameBuffer&) = delete;
         FrameBuffer& operator = (const FrameBuffer&) = delete;
 
+        void read_region(unsigned int slot, glm::uvec2 offset, glm::uvec2 size, ColorMode color, DataType data, void* bits);
+
+    friend class PixelReader;
     };
 }
@@ -0,0 +1,368 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "GpuProfiler.h"
+#include "util.h"
+
+#include <charconv>
+#include <fstream>
+
+namespace glow
+{
+    double to_milliseconds(std::chrono::steady_clock::duration duration) noexcept
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    void append_json_string(std::string& out, std::string_view value) noexcept
+    {
+        out += '"';
+        for (auto c : value)
+        {
+            switch (c)
+            {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    constexpr auto hex = "0123456789abcdef";
+                    out += "\\u00";
+                    out += hex[(c >> 4) & 0xf];
+                    out += hex[c & 0xf];
+                }
+                else
+                {
+                    out += c;
+                }
+                break;
+            }
+        }
+        out += '"';
+    }
+
+    // std::to_string follows the C locale, which may use a decimal comma
+    void append_json_number(std::string& out, double value) noexcept
+    {
+        auto buffer = std::array<char, 32>{};
+        auto [ptr, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, std::chars_format::fixed, 3);
+        GLOW_ASSERT(ec == std::errc{});
+        out.append(buffer.data(), ptr);
+    }
+
+    void append_trace_event(std::string& out, const std::string& name, double start, double duration, unsigned int tid) noexcept
+    {
+        if (out.back() != '[')
+        {
+            out += ",\n";
+        }
+        out += "{\"name\":";
+        append_json_string(out, name);
+        // chrome traces are in microseconds
+        out += ",\"cat\":\"" + std::string(tid == 0u ? "cpu" : "gpu") + "\"";
+        out += ",\"ph\":\"X\",\"ts\":";
+        append_json_number(out, start * 1000.0);
+        out += ",\"dur\":";
+        append_json_number(out, duration * 1000.0);
+        out += ",\"pid\":0,\"tid\":" + std::to_string(tid) + "}";
+    }
+
+    void append_trace_events(std::string& out, const std::vector<ProfileNode>& nodes, bool gpu) noexcept
+    {
+        for (const auto& node : nodes)
+        {
+            append_trace_event(out, node.name, node.cpu_start, node.cpu_time, 0u);
+            if (gpu)
+            {
+                append_trace_event(out, node.name, node.gpu_start, node.gpu_time, 1u);
+            }
+            append_trace_events(out, node.children, gpu);
+        }
+    }
+
+    GpuProfiler::GpuProfiler(size_t h)
+    : history(h)
+    {
+        GLOW_ASSERT(history > 0u);
+
+        supported = is_supported();
+        cpu_epoch = Clock::now();
+        if (supported)
+        {
+            // align the GPU timeline with the CPU timeline
+            glGetInteger64v(GL_TIMESTAMP, &gpu_epoch);
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    GpuProfiler::~GpuProfiler()
+    {
+        release_queries(current);
+        for (auto& f : pending)
+        {
+            release_queries(f);
+        }
+        if (!queries.empty())
+        {
+            glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    bool GpuProfiler::is_supported() noexcept
+    {
+        return GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+    }
+
+    void GpuProfiler::begin_frame() noexcept
+    {
+        GLOW_ASSERT(!in_frame);
+
+        // results arrive in order, stop at the first frame still in flight
+        while (!pending.empty() && is_available(pending.front()))
+        {
+            resolve(pending.front());
+            release_queries(pending.front());
+            pending.pop_front();
+        }
+
+        current.frame = frame++;
+        current.scopes.clear();
+        in_frame = true;
+    }
+
+    void GpuProfiler::end_frame() noexcept
+    {
+        GLOW_ASSERT(in_frame);
+        GLOW_ASSERT(stack.empty());
+
+        in_frame = false;
+        if (current.scopes.empty())
+        {
+            return;
+        }
+
+        pending.push_back(std::move(current));
+        current = {};
+    }
+
+    void GpuProfiler::begin(std::string_view name) noexcept
+    {
+        GLOW_ASSERT(in_frame);
+
+        auto scope = Scope{};
+        scope.name   = name;
+        scope.parent = stack.empty() ? SIZE_MAX : stack.back();
+        if (supported)
+        {
+            scope.begin_query = acquire_query();
+            scope.end_query   = acquire_query();
+            glQueryCounter(scope.begin_query, GL_TIMESTAMP);
+        }
+        scope.cpu_begin = Clock::now();
+
+        stack.push_back(current.scopes.size());
+        current.scopes.push_back(std::move(scope));
+    }
+
+    void GpuProfiler::end() noexcept
+    {
+        GLOW_ASSERT(!stack.empty());
+
+        auto& scope = current.scopes[stack.back()];
+        stack.pop_back();
+
+        scope.cpu_end = Clock::now();
+        if (supported)
+        {
+            glQueryCounter(scope.end_query, GL_TIMESTAMP);
+        }
+    }
+
+    size_t GpuProfiler::get_pending() const noexcept
+    {
+        return pending.size();
+    }
+
+    const std::deque<ProfileFrame>& GpuProfiler::get_frames() const noexcept
+    {
+        return frames;
+    }
+
+    const ProfileFrame* GpuProfiler::get_last_frame() const noexcept
+    {
+        if (frames.empty())
+        {
+            return nullptr;
+        }
+        return &frames.back();
+    }
+
+    std::string GpuProfiler::get_chrome_trace() const noexcept
+    {
+        auto out = std::string{"{\"traceEvents\":["};
+        for (const auto& f : frames)
+        {
+            append_trace_events(out, f.scopes, supported);
+        }
+        out += "],\"displayTimeUnit\":\"ms\"}\n";
+        return out;
+    }
+
+    void GpuProfiler::save_chrome_trace(const std::filesystem::path& file) const
+    {
+        auto out = std::ofstream(file, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            throw std::runtime_error("Failed to open " + file.string() + ".");
+        }
+
+        auto json = get_chrome_trace();
+        out.write(json.data(), json.size());
+        if (!out)
+        {
+            throw std::runtime_error("Failed to write " + file.string() + ".");
+        }
+    }
+
+    glm::uint GpuProfiler::acquire_query() noexcept
+    {
+        if (queries.empty())
+        {
+            auto id = GLuint{0};
+            glGenQueries(1, &id);
+            return id;
+        }
+
+        auto id = queries.back();
+        queries.pop_back();
+        return id;
+    }
+
+    void GpuProfiler::release_queries(Frame& f) noexcept
+    {
+        for (auto& scope : f.scopes)
+        {
+            if (scope.begin_query != 0u)
+            {
+                queries.push_back(scope.begin_query);
+                queries.push_back(scope.end_query);
+                scope.begin_query = 0u;
+                scope.end_query   = 0u;
+            }
+        }
+    }
+
+    bool GpuProfiler::is_available(const Frame& f) const noexcept
+    {
+        if (!supported)
+        {
+            return true;
+        }
+
+        // the last top level scope closes after all others
+        auto last = std::find_if(rbegin(f.scopes), rend(f.scopes), [] (const auto& scope) {
+            return scope.parent == SIZE_MAX;
+        });
+        GLOW_ASSERT(last != rend(f.scopes));
+
+        auto available = GLint{GL_FALSE};
+        glGetQueryObjectiv(last->end_query, GL_QUERY_RESULT_AVAILABLE, &available);
+        return available == GL_TRUE;
+    }
+
+    void GpuProfiler::resolve(Frame& f) noexcept
+    {
+        auto result = ProfileFrame{};
+        result.frame = f.frame;
+
+        // scopes are recorded in pre-order, parents come before their children
+        auto nodes = std::vector<ProfileNode>(f.scopes.size());
+        for (auto i = 0u; i < f.scopes.size(); i++)
+        {
+            const auto& scope = f.scopes[i];
+            auto& node = nodes[i];
+            node.name      = scope.name;
+            node.cpu_start = to_milliseconds(scope.cpu_begin - cpu_epoch);
+            node.cpu_time  = to_milliseconds(scope.cpu_end - scope.cpu_begin);
+            if (supported)
+            {
+                auto begin = GLuint64{0};
+                auto end   = GLuint64{0};
+                glGetQueryObjectui64v(scope.begin_query, GL_QUERY_RESULT, &begin);
+                glGetQueryObjectui64v(scope.end_query, GL_QUERY_RESULT, &end);
+                node.gpu_start = static_cast<double>(static_cast<std::int64_t>(begin) - gpu_epoch) / 1000000.0;
+                node.gpu_time  = static_cast<double>(end - begin) / 1000000.0;
+            }
+        }
+
+        // attach children back to front, so that the indexes stay valid
+        for (auto i = nodes.size(); i-- > 0u;)
+        {
+            auto parent = f.scopes[i].parent;
+            if (parent == SIZE_MAX)
+            {
+                continue;
+            }
+            auto& siblings = nodes[parent].children;
+            siblings.insert(siblings.begin(), std::move(nodes[i]));
+        }
+        for (auto i = 0u; i < nodes.size(); i++)
+        {
+            if (f.scopes[i].parent == SIZE_MAX)
+            {
+                result.scopes.push_back(std::move(nodes[i]));
+            }
+        }
+
+        frames.push_back(std::move(result));
+        while (frames.size() > history)
+        {
+            frames.pop_front();
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    GpuScope::GpuScope(GpuProfiler& p, std::string_view name) noexcept
+    : profiler(p)
+    {
+        profiler.begin(name);
+    }
+
+    GpuScope::~GpuScope()
+    {
+        profiler.end();
+    }
+}
@@ -0,0 +1,185 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "defines.h"
+
+namespace glow
+{
+    //! Timing of a profiled scope.
+    //!
+    //! Start times are in milliseconds since the profiler was created,
+    //! durations are in milliseconds.
+    struct GLOW_EXPORT ProfileNode
+    {
+        std::string              name;
+        double                   cpu_start = 0.0;
+        double                   cpu_time  = 0.0;
+        double                   gpu_start = 0.0;
+        double                   gpu_time  = 0.0;
+        std::vector<ProfileNode> children;
+    };
+
+    //! Timings of one frame.
+    struct GLOW_EXPORT ProfileFrame
+    {
+        std::uint64_t            frame = 0u;
+        std::vector<ProfileNode> scopes;
+    };
+
+    //! GPU Profiler
+    //!
+    //! The GPU profiler measures the GPU and CPU time of nested scopes,
+    //! such as render passes and the draw batches in them.
+    //!
+    //! Each scope places two timestamp queries, taken from a pool of
+    //! recycled queries. The results are only read once they are
+    //! available, usually a few frames later, so profiling never stalls
+    //! the pipeline. The most recent resolved frames are kept as a tree
+    //! of ProfileNode and can be exported as Chrome trace JSON, to be
+    //! viewed in chrome://tracing or Perfetto.
+    //!
+    //! If neither OpenGL 3.3 nor ARB_timer_query is available only the
+    //! CPU time is measured.
+    class GLOW_EXPORT GpuProfiler
+    {
+    public:
+        //! Create a GPU profiler.
+        //!
+        //! @param history the number of resolved frames to keep
+        GpuProfiler(size_t history = 120u);
+
+        //! Release all queries.
+        ~GpuProfiler();
+
+        //! Check if GPU timer queries are supported.
+        static bool is_supported() noexcept;
+
+        //! Start a new frame.
+        //!
+        //! Resolves all previous frames whose queries are available.
+        void begin_frame() noexcept;
+
+        //! End the current frame.
+        void end_frame() noexcept;
+
+        //! Open a scope.
+        //!
+        //! Scopes must be closed in reverse order and within the frame.
+        //!
+        //! @param name the name of the scope
+        void begin(std::string_view name) noexcept;
+
+        //! Close the innermost scope.
+        void end() noexcept;
+
+        //! Get the number of frames waiting for query results.
+        size_t get_pending() const noexcept;
+
+        //! Get the resolved frames, oldest first.
+        const std::deque<ProfileFrame>& get_frames() const noexcept;
+
+        //! Get the most recently resolved frame.
+        //!
+        //! @return the frame or nullptr if no frame was resolved yet
+        const ProfileFrame* get_last_frame() const noexcept;
+
+        //! Export the resolved frames as Chrome trace JSON.
+        //!
+        //! GPU scopes are placed on thread 1 and CPU scopes on thread 0.
+        std::string get_chrome_trace() const noexcept;
+
+        //! Write the resolved frames as Chrome trace JSON.
+        //!
+        //! @param file the file to write
+        void save_chrome_trace(const std::filesystem::path& file) const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Scope
+        {
+            std::string       name;
+            size_t            parent      = SIZE_MAX;
+            glm::uint         begin_query = 0u;
+            glm::uint         end_query   = 0u;
+            Clock::time_point cpu_begin;
+            Clock::time_point cpu_end;
+        };
+
+        struct Frame
+        {
+            std::uint64_t      frame = 0u;
+            std::vector<Scope> scopes;
+        };
+
+        size_t                   history   = 0u;
+        bool                     supported = false;
+        std::uint64_t            frame     = 0u;
+        bool                     in_frame  = false;
+        Clock::time_point        cpu_epoch;
+        std::int64_t             gpu_epoch = 0;
+        Frame                    current;
+        std::vector<size_t>      stack;
+        std::deque<Frame>        pending;
+        std::deque<ProfileFrame> frames;
+        std::vector<glm::uint>   queries;
+
+        glm::uint acquire_query() noexcept;
+        void release_queries(Frame& frame) noexcept;
+        bool is_available(const Frame& frame) const noexcept;
+        void resolve(Frame& frame) noexcept;
+
+        GpuProfiler(const GpuProfiler&) = delete;
+        GpuProfiler& operator = (const GpuProfiler&) = delete;
+    };
+
+    //! Profile Scope
+    //!
+    //! Opens a scope on a GPU profiler for its lifetime.
+    class GLOW_EXPORT GpuScope
+    {
+    public:
+        //! Open a scope.
+        //!
+        //! @param profiler the profiler to use
+        //! @param name the name of the scope
+        GpuScope(GpuProfiler& profiler, std::string_view name) noexcept;
+
+        //! Close the scope.
+        ~GpuScope();
+
+    private:
+        GpuProfiler& profiler;
+
+        GpuScope(const GpuScope&) = delete;
+        GpuScope& operator = (const GpuScope&) = delete;
+    };
+}
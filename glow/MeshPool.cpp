@@ -0,0 +1,266 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "MeshPool.h"
+#include "StateCache.h"
+#include "util.h"
+
+namespace glow
+{
+    MeshPool::MeshPool(const VertexLayout& l, unsigned int mv, unsigned int mi, FacesType t)
+    : layout(l), type(t), max_vertices(mv), max_indexes(mi)
+    {
+        GLOW_ASSERT(layout.get_stride() > 0u);
+
+        auto vertex_size = static_cast<size_t>(max_vertices) * layout.get_stride();
+        auto index_size  = static_cast<size_t>(max_indexes) * sizeof(unsigned int);
+
+        if (has_direct_state_access())
+        {
+            glCreateVertexArrays(1, &vao);
+            glCreateBuffers(1, &vertex_buffer);
+            glCreateBuffers(1, &index_buffer);
+
+            glNamedBufferStorage(vertex_buffer, vertex_size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+            glNamedBufferStorage(index_buffer, index_size, nullptr, GL_DYNAMIC_STORAGE_BIT);
+            glVertexArrayElementBuffer(vao, index_buffer);
+        }
+        else
+        {
+            glGenVertexArrays(1, &vao);
+            glGenBuffers(1, &vertex_buffer);
+            glGenBuffers(1, &index_buffer);
+
+            glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+            glBufferData(GL_ARRAY_BUFFER, vertex_size, nullptr, GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+            // the element buffer binding is part of the vertex array state
+            StateCache::get().bind_vertex_array(vao);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_size, nullptr, GL_STATIC_DRAW);
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    MeshPool::~MeshPool()
+    {
+        for (auto glid : {vertex_buffer, index_buffer, instance_buffer})
+        {
+            if (glid != 0)
+            {
+                glDeleteBuffers(1, &glid);
+            }
+        }
+
+        glDeleteVertexArrays(1, &vao);
+        StateCache::get().release_vertex_array(vao);
+        vao = 0;
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    const VertexLayout& MeshPool::get_layout() const noexcept
+    {
+        return layout;
+    }
+
+    FacesType MeshPool::get_faces_type() const noexcept
+    {
+        return type;
+    }
+
+    unsigned int MeshPool::get_vertex_count() const noexcept
+    {
+        return vertex_count;
+    }
+
+    unsigned int MeshPool::get_index_count() const noexcept
+    {
+        return index_count;
+    }
+
+    MeshRange MeshPool::add(unsigned int vcount, const void* vertices, unsigned int icount, const unsigned int* indexes) noexcept
+    {
+        GLOW_DEBUG_GROUP("MeshPool::add");
+        GLOW_ASSERT(icount > 0u);
+
+        if (vertex_count + vcount > max_vertices || index_count + icount > max_indexes)
+        {
+            return {};
+        }
+
+        auto stride = layout.get_stride();
+        if (has_direct_state_access())
+        {
+            glNamedBufferSubData(vertex_buffer, static_cast<size_t>(vertex_count) * stride, static_cast<size_t>(vcount) * stride, vertices);
+            glNamedBufferSubData(index_buffer, index_count * sizeof(unsigned int), icount * sizeof(unsigned int), indexes);
+        }
+        else
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<size_t>(vertex_count) * stride, static_cast<size_t>(vcount) * stride, vertices);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+            glBindBuffer(GL_COPY_WRITE_BUFFER, index_buffer);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, index_count * sizeof(unsigned int), icount * sizeof(unsigned int), indexes);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+
+        GLOW_CHECK_GLERROR();
+
+        auto mesh = MeshRange{index_count, icount, static_cast<int>(vertex_count)};
+        vertex_count += vcount;
+        index_count  += icount;
+        return mesh;
+    }
+
+    void MeshPool::clear() noexcept
+    {
+        vertex_count = 0u;
+        index_count  = 0u;
+    }
+
+    void MeshPool::upload_instance_values(const VertexLayout& l, unsigned int count, const void* data) noexcept
+    {
+        GLOW_DEBUG_GROUP("MeshPool::upload_instance_values");
+        GLOW_ASSERT(l.get_stride() > 0u);
+
+        instance_layout = l;
+        dirty           = true;
+
+        auto size = static_cast<size_t>(count) * l.get_stride();
+        if (has_direct_state_access())
+        {
+            if (instance_buffer == 0u)
+            {
+                glCreateBuffers(1, &instance_buffer);
+            }
+            glNamedBufferData(instance_buffer, size, data, GL_STATIC_DRAW);
+        }
+        else
+        {
+            if (instance_buffer == 0u)
+            {
+                glGenBuffers(1, &instance_buffer);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
+            glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void MeshPool::bind_attributes(const Shader& shader, const VertexLayout& l, unsigned int buffer, unsigned int divisor) noexcept
+    {
+        // vertices and instances use their own buffer binding point
+        auto dsa     = has_direct_state_access();
+        auto binding = divisor;
+        if (dsa)
+        {
+            glVertexArrayVertexBuffer(vao, binding, buffer, 0, l.get_stride());
+            glVertexArrayBindingDivisor(vao, binding, divisor);
+        }
+        else
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        }
+
+        for (const auto& attribute : l.get_attributes())
+        {
+            auto adr = shader.get_attribute(attribute.name);
+            if (adr == -1)
+            {
+                continue;
+            }
+
+            if (dsa)
+            {
+                glVertexArrayAttribFormat(vao, adr, attribute.components, get_gl_attribute_type(attribute.type),
+                                          attribute.normalized ? GL_TRUE : GL_FALSE, attribute.offset);
+                glVertexArrayAttribBinding(vao, adr, binding);
+                glEnableVertexArrayAttrib(vao, adr);
+            }
+            else
+            {
+                glVertexAttribPointer(adr, attribute.components, get_gl_attribute_type(attribute.type),
+                                      attribute.normalized ? GL_TRUE : GL_FALSE, l.get_stride(),
+                                      reinterpret_cast<const void*>(static_cast<size_t>(attribute.offset)));
+                glVertexAttribDivisor(adr, divisor);
+                glEnableVertexAttribArray(adr);
+            }
+            enabled.push_back(adr);
+        }
+    }
+
+    void MeshPool::bind(Shader& shader) noexcept
+    {
+        StateCache::get().bind_vertex_array(vao);
+
+        if (!dirty && shader.get_attribute_interface() == bound_interface)
+        {
+            return;
+        }
+
+        for (auto adr : enabled)
+        {
+            glDisableVertexAttribArray(adr);
+        }
+        enabled.clear();
+
+        bind_attributes(shader, layout, vertex_buffer, 0u);
+
+        if (instance_buffer != 0u)
+        {
+            bind_attributes(shader, instance_layout, instance_buffer, 1u);
+        }
+
+        if (!has_direct_state_access())
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+
+        bound_interface = shader.get_attribute_interface();
+        dirty           = false;
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void MeshPool::unbind() noexcept
+    {
+        StateCache::get().bind_vertex_array(0);
+        GLOW_CHECK_GLERROR();
+    }
+
+    void MeshPool::draw(const MeshRange& mesh) noexcept
+    {
+        GLOW_ASSERT(mesh.is_valid());
+
+        glDrawElementsBaseVertex(get_gl_facetype(type), mesh.index_count, GL_UNSIGNED_INT,
+                                 reinterpret_cast<const void*>(mesh.first_index * sizeof(unsigned int)),
+                                 mesh.base_vertex);
+
+        GLOW_CHECK_GLERROR();
+    }
+}
@@ -0,0 +1,147 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "defines.h"
+#include "Shader.h"
+#include "VertexLayout.h"
+#include "VertexBuffer.h"
+
+namespace glow
+{
+    //! Mesh in a mesh pool.
+    struct MeshRange
+    {
+        //! The first index in the pool's index buffer.
+        unsigned int first_index = 0u;
+        //! The number of indexes.
+        unsigned int index_count = 0u;
+        //! The offset added to each index.
+        int          base_vertex = 0;
+
+        //! Check if the mesh was added.
+        bool is_valid() const noexcept
+        {
+            return index_count != 0u;
+        }
+    };
+
+    //! Mesh Pool
+    //!
+    //! The mesh pool stores many meshes with the same vertex layout in one
+    //! shared vertex buffer and one shared index buffer. Meshes are
+    //! addressed by their index range and base vertex, so that all meshes
+    //! can be drawn with one vertex array and, through DrawBatch, with one
+    //! multi draw call.
+    //!
+    //! Meshes are allocated linearly and only released all at once with
+    //! clear, the pool is intended for static geometry.
+    //!
+    //! @see DrawBatch
+    class GLOW_EXPORT MeshPool
+    {
+    public:
+        //! Create a mesh pool.
+        //!
+        //! @param layout the layout of the vertices
+        //! @param max_vertices the capacity in vertices
+        //! @param max_indexes the capacity in indexes
+        //! @param type the faces type of all meshes
+        MeshPool(const VertexLayout& layout, unsigned int max_vertices, unsigned int max_indexes, FacesType type = FacesType::TRIANGLES);
+
+        //! Release mesh pool.
+        ~MeshPool();
+
+        //! Get the vertex layout.
+        const VertexLayout& get_layout() const noexcept;
+
+        //! Get the faces type.
+        FacesType get_faces_type() const noexcept;
+
+        //! Get the number of vertices in use.
+        unsigned int get_vertex_count() const noexcept;
+
+        //! Get the number of indexes in use.
+        unsigned int get_index_count() const noexcept;
+
+        //! Add a mesh.
+        //!
+        //! @param vertex_count the number of vertices
+        //! @param vertices the vertex data in the pool's layout
+        //! @param index_count the number of indexes
+        //! @param indexes the indexes, relative to the mesh's first vertex
+        //! @return the mesh range, invalid if the pool is full
+        MeshRange add(unsigned int vertex_count, const void* vertices, unsigned int index_count, const unsigned int* indexes) noexcept;
+
+        //! Remove all meshes.
+        void clear() noexcept;
+
+        //! Upload per instance values.
+        //!
+        //! DrawBatch assigns each draw its own range of instances, so
+        //! per instance values can hold per object data, such as
+        //! transforms.
+        //!
+        //! @param layout the layout of the instance values
+        //! @param count the number of instances
+        //! @param data the instance data
+        void upload_instance_values(const VertexLayout& layout, unsigned int count, const void* data) noexcept;
+
+        //! Bind mesh pool to shader.
+        //!
+        //! As with VertexBuffer::bind, the vertex array is only
+        //! reconfigured if the shader's attribute interface changed.
+        //!
+        //! @param shader the shader to bind to
+        void bind(Shader& shader) noexcept;
+
+        //! Unbind mesh pool.
+        void unbind() noexcept;
+
+        //! Draw a single mesh.
+        //!
+        //! @param mesh the mesh to draw
+        void draw(const MeshRange& mesh) noexcept;
+
+    private:
+        VertexLayout layout;
+        VertexLayout instance_layout;
+        FacesType    type;
+        unsigned int vao             = 0u;
+        unsigned int vertex_buffer   = 0u;
+        unsigned int index_buffer    = 0u;
+        unsigned int instance_buffer = 0u;
+        unsigned int max_vertices    = 0u;
+        unsigned int max_indexes     = 0u;
+        unsigned int vertex_count    = 0u;
+        unsigned int index_count     = 0u;
+
+        std::vector<unsigned int> enabled;
+        size_t                    bound_interface = 0u;
+        bool                      dirty           = true;
+
+        void bind_attributes(const Shader& shader, const VertexLayout& layout, unsigned int buffer, unsigned int divisor) noexcept;
+
+        MeshPool(const MeshPool&) = delete;
+        MeshPool& operator = (const MeshPool&) = delete;
+    };
+}
@@ -0,0 +1,469 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "MipChain.h"
+#include "util.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <thread>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define GLOW_SSE2
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define GLOW_AVX2
+#define GLOW_TARGET_AVX2
+#elif defined(__GNUC__)
+#define GLOW_AVX2
+#define GLOW_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define GLOW_NEON
+#endif
+
+namespace glow
+{
+#if defined(GLOW_AVX2)
+    bool has_avx2() noexcept
+    {
+        #if defined(_MSC_VER)
+        auto info = std::array<int, 4>{};
+        __cpuid(info.data(), 0);
+        if (info[0] < 7)
+        {
+            return false;
+        }
+        // the OS must save the YMM registers
+        __cpuid(info.data(), 1);
+        if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6u) != 6u)
+        {
+            return false;
+        }
+        __cpuidex(info.data(), 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+        #else
+        return __builtin_cpu_supports("avx2");
+        #endif
+    }
+
+    // compiled for AVX2 regardless of the build flags, only called if the CPU supports it
+    GLOW_TARGET_AVX2 size_t accumulate_avx2(float* dst, const float* src, float weight, size_t count) noexcept
+    {
+        auto i = size_t{0};
+        auto weight8 = _mm256_set1_ps(weight);
+        for (; i + 8u <= count; i += 8u)
+        {
+            auto value = _mm256_mul_ps(_mm256_loadu_ps(src + i), weight8);
+            _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), value));
+        }
+        return i;
+    }
+#endif
+
+    // dst += src * weight, the hot loop of the vertical pass
+    void accumulate(float* dst, const float* src, float weight, size_t count) noexcept
+    {
+        auto i = size_t{0};
+
+        #if defined(GLOW_AVX2)
+        static const auto avx2 = has_avx2();
+        if (avx2)
+        {
+            i = accumulate_avx2(dst, src, weight, count);
+        }
+        #endif
+
+        #if defined(GLOW_SSE2)
+        auto weight4 = _mm_set1_ps(weight);
+        for (; i + 4u <= count; i += 4u)
+        {
+            auto value = _mm_mul_ps(_mm_loadu_ps(src + i), weight4);
+            _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), value));
+        }
+        #elif defined(GLOW_NEON)
+        auto weight4 = vdupq_n_f32(weight);
+        for (; i + 4u <= count; i += 4u)
+        {
+            vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), weight4));
+        }
+        #endif
+
+        for (; i < count; i++)
+        {
+            dst[i] += src[i] * weight;
+        }
+    }
+
+    template <typename Func>
+    void parallel_for(size_t count, unsigned int threads, Func func)
+    {
+        constexpr auto CHUNK = size_t{16};
+
+        auto chunks  = (count + CHUNK - 1u) / CHUNK;
+        auto workers = std::min<size_t>(threads, chunks);
+        if (workers <= 1u)
+        {
+            for (auto i = size_t{0}; i < count; i++)
+            {
+                func(i);
+            }
+            return;
+        }
+
+        auto next = std::atomic<size_t>{0};
+        auto work = [&] () {
+            for (auto start = next.fetch_add(CHUNK); start < count; start = next.fetch_add(CHUNK))
+            {
+                for (auto i = start; i < std::min(start + CHUNK, count); i++)
+                {
+                    func(i);
+                }
+            }
+        };
+
+        auto pool = std::vector<std::thread>{};
+        for (auto i = size_t{1}; i < workers; i++)
+        {
+            pool.emplace_back(work);
+        }
+        work();
+        for (auto& thread : pool)
+        {
+            thread.join();
+        }
+    }
+
+    // filter taps of one output pixel
+    struct Taps
+    {
+        int                  first = 0;
+        std::array<float, 6> weights = {};
+        int                  count = 0;
+    };
+
+    double bessel_i0(double x) noexcept
+    {
+        auto sum  = 1.0;
+        auto term = 1.0;
+        for (auto k = 1; k < 32; k++)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum  += term;
+        }
+        return sum;
+    }
+
+    // taps of a 2:1 reduction, relative to the first source pixel
+    Taps get_taps(MipmapFilter filter) noexcept
+    {
+        auto taps = Taps{};
+        switch (filter)
+        {
+        case MipmapFilter::BOX:
+            taps.first   = 0;
+            taps.count   = 2;
+            taps.weights = {0.5f, 0.5f};
+            break;
+        case MipmapFilter::KAISER:
+        {
+            constexpr auto radius = 3.0;
+            constexpr auto beta   = 4.0;
+
+            taps.first = -2;
+            taps.count = 6;
+
+            auto sum = 0.0;
+            auto weights = std::array<double, 6>{};
+            for (auto i = 0; i < taps.count; i++)
+            {
+                // distance from the center of the output pixel in source pixels
+                auto d    = i + taps.first - 0.5;
+                auto x    = std::numbers::pi * d / 2.0;
+                auto sinc = std::sin(x) / x;
+                auto r    = d / radius;
+                weights[i] = sinc * bessel_i0(beta * std::sqrt(1.0 - r * r)) / bessel_i0(beta);
+                sum += weights[i];
+            }
+            for (auto i = 0; i < taps.count; i++)
+            {
+                taps.weights[i] = static_cast<float>(weights[i] / sum);
+            }
+            break;
+        }
+        default:
+            GLOW_FAIL("Unknown mipmap filter.");
+            break;
+        }
+        return taps;
+    }
+
+    float srgb_to_linear(float value) noexcept
+    {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float linear_to_srgb(float value) noexcept
+    {
+        return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    template <typename T>
+    void load_values(const std::byte* src, float* dst, size_t count) noexcept
+    {
+        auto values = reinterpret_cast<const T*>(src);
+        for (auto i = size_t{0}; i < count; i++)
+        {
+            dst[i] = static_cast<float>(values[i]);
+        }
+    }
+
+    template <typename T>
+    void store_values(const float* src, std::byte* dst, size_t count) noexcept
+    {
+        auto values = reinterpret_cast<T*>(dst);
+        for (auto i = size_t{0}; i < count; i++)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                values[i] = static_cast<T>(src[i]);
+            }
+            else
+            {
+                auto value = std::round(src[i]);
+                value = std::clamp(value, static_cast<float>(std::numeric_limits<T>::lowest()), static_cast<float>(std::numeric_limits<T>::max()));
+                values[i] = static_cast<T>(value);
+            }
+        }
+    }
+
+    // convert a row to floats, UINT8 is normalized as it is sampled normalized
+    void load_row(const std::byte* src, float* dst, size_t count, DataType data, const std::array<float, 256>* srgb, size_t components) noexcept
+    {
+        switch (data)
+        {
+        case DataType::INT8:
+            load_values<std::int8_t>(src, dst, count);
+            break;
+        case DataType::UINT8:
+            for (auto i = size_t{0}; i < count; i++)
+            {
+                auto value = std::to_integer<unsigned int>(src[i]);
+                auto alpha = components == 4u && i % 4u == 3u;
+                dst[i] = srgb != nullptr && !alpha ? (*srgb)[value] : value / 255.0f;
+            }
+            break;
+        case DataType::INT16:
+            load_values<std::int16_t>(src, dst, count);
+            break;
+        case DataType::UINT16:
+            load_values<std::uint16_t>(src, dst, count);
+            break;
+        case DataType::INT32:
+            load_values<std::int32_t>(src, dst, count);
+            break;
+        case DataType::UINT32:
+            load_values<std::uint32_t>(src, dst, count);
+            break;
+        case DataType::FLOAT:
+            std::memcpy(dst, src, count * sizeof(float));
+            break;
+        case DataType::DOUBLE:
+            load_values<double>(src, dst, count);
+            break;
+        default:
+            GLOW_FAIL("Unexpected type.");
+            break;
+        }
+    }
+
+    void store_row(const float* src, std::byte* dst, size_t count, DataType data, bool srgb, size_t components) noexcept
+    {
+        switch (data)
+        {
+        case DataType::INT8:
+            store_values<std::int8_t>(src, dst, count);
+            break;
+        case DataType::UINT8:
+            for (auto i = size_t{0}; i < count; i++)
+            {
+                auto alpha = components == 4u && i % 4u == 3u;
+                auto value = srgb && !alpha ? linear_to_srgb(src[i]) : src[i];
+                dst[i] = static_cast<std::byte>(std::clamp(value * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+            break;
+        case DataType::INT16:
+            store_values<std::int16_t>(src, dst, count);
+            break;
+        case DataType::UINT16:
+            store_values<std::uint16_t>(src, dst, count);
+            break;
+        case DataType::INT32:
+            store_values<std::int32_t>(src, dst, count);
+            break;
+        case DataType::UINT32:
+            store_values<std::uint32_t>(src, dst, count);
+            break;
+        case DataType::FLOAT:
+            std::memcpy(dst, src, count * sizeof(float));
+            break;
+        case DataType::DOUBLE:
+            store_values<double>(src, dst, count);
+            break;
+        default:
+            GLOW_FAIL("Unexpected type.");
+            break;
+        }
+    }
+
+    MipChain::MipChain(glm::uvec2 size, ColorMode c, DataType d, const void* bits, MipmapFilter filter, bool srgb, unsigned int threads)
+    : color(c), data(d)
+    {
+        GLOW_ASSERT(size.x > 0u && size.y > 0u);
+        GLOW_ASSERT(color != ColorMode::UNKNOWN && color != ColorMode::DEPTH);
+        GLOW_ASSERT(data != DataType::UNKNOWN);
+        GLOW_ASSERT(!srgb || data == DataType::UINT8);
+        GLOW_ASSERT(bits != nullptr);
+
+        if (threads == 0u)
+        {
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+
+        auto components = get_pixel_size(color, DataType::UINT8);
+        auto pixel_size = get_pixel_size(color, data);
+
+        auto base = static_cast<const std::byte*>(bits);
+        sizes.push_back(size);
+        images.emplace_back(base, base + size_t{size.x} * size.y * pixel_size);
+
+        auto srgb_table = std::array<float, 256>{};
+        for (auto i = 0u; i < 256u; i++)
+        {
+            srgb_table[i] = srgb_to_linear(i / 255.0f);
+        }
+        auto table = srgb ? &srgb_table : nullptr;
+
+        auto taps = get_taps(filter);
+
+        auto source = std::vector<float>{};
+        auto temp   = std::vector<float>{};
+        auto target = std::vector<float>{};
+
+        while (size.x > 1u || size.y > 1u)
+        {
+            auto next = glm::uvec2(std::max(size.x >> 1u, 1u), std::max(size.y >> 1u, 1u));
+
+            auto src_row = size_t{size.x} * components;
+            auto dst_row = size_t{next.x} * components;
+
+            source.resize(src_row * size.y);
+            temp.assign(dst_row * size.y, 0.0f);
+            target.assign(dst_row * next.y, 0.0f);
+
+            // load and horizontal pass, a 1 pixel wide level is copied
+            const auto& previous = images.back();
+            auto sx = size.x > 1u ? 2 : 1;
+            parallel_for(size.y, threads, [&] (size_t y) {
+                auto src = source.data() + y * src_row;
+                auto dst = temp.data() + y * dst_row;
+                load_row(previous.data() + y * size.x * pixel_size, src, src_row, data, table, components);
+                for (auto x = 0; x < static_cast<int>(next.x); x++)
+                {
+                    for (auto t = 0; t < taps.count; t++)
+                    {
+                        auto i = std::clamp(x * sx + (sx == 2 ? taps.first + t : 0), 0, static_cast<int>(size.x) - 1);
+                        for (auto k = size_t{0}; k < components; k++)
+                        {
+                            dst[x * components + k] += taps.weights[t] * src[i * components + k];
+                        }
+                    }
+                }
+            });
+
+            // vertical pass over whole rows and store
+            auto sy = size.y > 1u ? 2 : 1;
+            auto image = std::vector<std::byte>(size_t{next.x} * next.y * pixel_size);
+            parallel_for(next.y, threads, [&] (size_t y) {
+                auto dst = target.data() + y * dst_row;
+                for (auto t = 0; t < taps.count; t++)
+                {
+                    auto i = std::clamp(static_cast<int>(y) * sy + (sy == 2 ? taps.first + t : 0), 0, static_cast<int>(size.y) - 1);
+                    accumulate(dst, temp.data() + i * dst_row, taps.weights[t], dst_row);
+                }
+                store_row(dst, image.data() + y * next.x * pixel_size, dst_row, data, srgb, components);
+            });
+
+            sizes.push_back(next);
+            images.push_back(std::move(image));
+            size = next;
+        }
+    }
+
+    int MipChain::get_levels() const noexcept
+    {
+        return static_cast<int>(images.size());
+    }
+
+    glm::uvec2 MipChain::get_size(int level) const noexcept
+    {
+        GLOW_ASSERT(level >= 0 && level < get_levels());
+        return sizes[level];
+    }
+
+    const void* MipChain::get_data(int level) const noexcept
+    {
+        GLOW_ASSERT(level >= 0 && level < get_levels());
+        return images[level].data();
+    }
+
+    void MipChain::upload(Texture& texture) const noexcept
+    {
+        GLOW_DEBUG_GROUP("MipChain::upload");
+        GLOW_ASSERT(texture.get_size() == sizes.front());
+        GLOW_ASSERT(texture.get_color_mode() == color && texture.get_data_type() == data);
+
+        auto levels = std::min(texture.get_mipmap_levels(), get_levels());
+        for (auto level = 0; level < levels; level++)
+        {
+            texture.upload_level(level, images[level].data());
+        }
+    }
+
+    void MipChain::upload(Texture& texture, CubeFace face) const noexcept
+    {
+        GLOW_DEBUG_GROUP("MipChain::upload");
+        GLOW_ASSERT(texture.get_size() == sizes.front());
+        GLOW_ASSERT(texture.get_color_mode() == color && texture.get_data_type() == data);
+
+        auto levels = std::min(texture.get_mipmap_levels(), get_levels());
+        for (auto level = 0; level < levels; level++)
+        {
+            texture.upload_level(face, level, images[level].data());
+        }
+    }
+}
@@ -0,0 +1,101 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <vector>
+
+#include "defines.h"
+#include "Texture.h"
+
+namespace glow
+{
+    //! Mipmap Filter
+    enum class MipmapFilter
+    {
+        //! Average each 2x2 block, fast but slightly blurry.
+        BOX,
+        //! Kaiser windowed sinc, sharper at a higher cost.
+        KAISER
+    };
+
+    //! Mip Chain
+    //!
+    //! The mip chain builds the mipmap levels of an image on the CPU.
+    //! Unlike Texture::generate_mipmaps this works for all color modes
+    //! and data types, does not need a context and can run on a worker
+    //! thread while loading assets. The levels are then uploaded one by
+    //! one into immutable texture storage.
+    //!
+    //! Each level is filtered from the previous one with a separable
+    //! filter in floating point. Values of sRGB images are averaged in
+    //! linear space; the alpha channel is always linear. The vertical
+    //! pass is vectorized with SSE2 or NEON, and with AVX2 if the CPU
+    //! supports it. The rows may be spread across threads.
+    //!
+    //! @note Integer values above 2^24 lose precision while filtering.
+    class GLOW_EXPORT MipChain
+    {
+    public:
+        //! Build a mip chain.
+        //!
+        //! @param size the size of the image in pixels
+        //! @param color the color mode, DEPTH is not supported
+        //! @param data the data type
+        //! @param bits the image with tightly packed rows
+        //! @param filter the filter to use
+        //! @param srgb the image has sRGB encoded UINT8 colors
+        //! @param threads the number of threads to use, 1 for only the
+        //! calling thread, 0 for one per core
+        MipChain(glm::uvec2 size, ColorMode color, DataType data, const void* bits, MipmapFilter filter = MipmapFilter::BOX, bool srgb = false, unsigned int threads = 1u);
+
+        //! Get the number of levels, including the image itself.
+        int get_levels() const noexcept;
+
+        //! Get the size of a level in pixels.
+        //!
+        //! @param level the mipmap level
+        glm::uvec2 get_size(int level) const noexcept;
+
+        //! Get the data of a level.
+        //!
+        //! @param level the mipmap level
+        //! @return the pixels in the color mode and data type of the image
+        const void* get_data(int level) const noexcept;
+
+        //! Upload the chain into an allocated 2D texture.
+        //!
+        //! @param texture the texture allocated with the same size and format
+        void upload(Texture& texture) const noexcept;
+
+        //! Upload the chain into a face of an allocated cube map.
+        //!
+        //! @param texture the texture allocated with the same size and format
+        //! @param face the cube map face
+        void upload(Texture& texture, CubeFace face) const noexcept;
+
+    private:
+        ColorMode                            color = ColorMode::UNKNOWN;
+        DataType                             data  = DataType::UNKNOWN;
+        std::vector<glm::uvec2>              sizes;
+        std::vector<std::vector<std::byte>>  images;
+    };
+}
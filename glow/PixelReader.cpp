@@ -0,0 +1,260 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "PixelReader.h"
+#include "FrameBuffer.h"
+#include "util.h"
+
+#include <cstring>
+#include <memory>
+
+namespace glow
+{
+    constexpr auto READ_FLAGS = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    // one second
+    constexpr auto READ_TIMEOUT = GLuint64{1000000000};
+
+    ReadCallback make_promise_callback(std::future<std::vector<std::byte>>& future)
+    {
+        // std::function must be copyable, std::promise is not
+        auto promise = std::make_shared<std::promise<std::vector<std::byte>>>();
+        future = promise->get_future();
+        return [promise] (const void* data, size_t size) {
+            auto bytes = static_cast<const std::byte*>(data);
+            promise->set_value(std::vector<std::byte>(bytes, bytes + size));
+        };
+    }
+
+    // slot offsets must be a multiple of the pixel type size
+    constexpr auto SLOT_ALIGNMENT = size_t{16};
+
+    PixelReader::PixelReader(size_t s, unsigned int c)
+    : slot_size((s + SLOT_ALIGNMENT - 1u) / SLOT_ALIGNMENT * SLOT_ALIGNMENT), slot_count(c)
+    {
+        GLOW_ASSERT(slot_size > 0u);
+        GLOW_ASSERT(slot_count > 0u);
+
+        persistent = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+
+        auto size = slot_size * slot_count;
+
+        glGenBuffers(1, &glid);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, glid);
+        if (persistent)
+        {
+            glBufferStorage(GL_PIXEL_PACK_BUFFER, size, nullptr, READ_FLAGS);
+            memory = static_cast<std::byte*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, READ_FLAGS));
+        }
+        else
+        {
+            glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        if (persistent && memory == nullptr)
+        {
+            glDeleteBuffers(1, &glid);
+            glid = 0u;
+            throw std::runtime_error("Failed to map pixel read buffer.");
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    PixelReader::~PixelReader()
+    {
+        wait_all();
+
+        if (glid != 0)
+        {
+            if (persistent)
+            {
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, glid);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            }
+            glDeleteBuffers(1, &glid);
+            glid = 0;
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    bool PixelReader::is_persistent() const noexcept
+    {
+        return persistent;
+    }
+
+    size_t PixelReader::get_slot_size() const noexcept
+    {
+        return slot_size;
+    }
+
+    size_t PixelReader::get_pending() const noexcept
+    {
+        return requests.size();
+    }
+
+    void PixelReader::read_pixels(FrameBuffer& buffer, unsigned int slot, glm::uvec2 offset, glm::uvec2 size, ColorMode color, DataType data, ReadCallback callback) noexcept
+    {
+        GLOW_DEBUG_GROUP("PixelReader::read_pixels");
+        auto bytes = size_t{size.x} * size.y * get_pixel_size(color, data);
+        GLOW_ASSERT(bytes <= slot_size);
+
+        auto index = begin_read();
+        // with a pixel pack buffer bound the pointer is an offset into the buffer
+        buffer.read_region(slot, offset, size, color, data, reinterpret_cast<void*>(index * slot_size));
+        end_read(index, bytes, std::move(callback));
+    }
+
+    std::future<std::vector<std::byte>> PixelReader::read_pixels(FrameBuffer& buffer, unsigned int slot, glm::uvec2 offset, glm::uvec2 size, ColorMode color, DataType data) noexcept
+    {
+        GLOW_DEBUG_GROUP("PixelReader::read_pixels");
+        auto future = std::future<std::vector<std::byte>>{};
+        read_pixels(buffer, slot, offset, size, color, data, make_promise_callback(future));
+        return future;
+    }
+
+    void PixelReader::read_pixels(Texture& texture, int level, ReadCallback callback) noexcept
+    {
+        GLOW_DEBUG_GROUP("PixelReader::read_pixels");
+        GLOW_ASSERT(texture.type == TextureType::TEXTURE2D);
+
+        auto level_size = glm::uvec2(std::max(texture.size.x >> level, 1u), std::max(texture.size.y >> level, 1u));
+        auto bytes      = size_t{level_size.x} * level_size.y * get_pixel_size(texture.color, texture.data);
+        GLOW_ASSERT(bytes <= slot_size);
+
+        auto index = begin_read();
+        texture.read_level(GL_TEXTURE_2D, level, reinterpret_cast<void*>(index * slot_size));
+        end_read(index, bytes, std::move(callback));
+    }
+
+    std::future<std::vector<std::byte>> PixelReader::read_pixels(Texture& texture, int level) noexcept
+    {
+        GLOW_DEBUG_GROUP("PixelReader::read_pixels");
+        auto future = std::future<std::vector<std::byte>>{};
+        read_pixels(texture, level, make_promise_callback(future));
+        return future;
+    }
+
+    void PixelReader::read_pixels(Texture& texture, CubeFace face, int level, ReadCallback callback) noexcept
+    {
+        GLOW_DEBUG_GROUP("PixelReader::read_pixels");
+        GLOW_ASSERT(texture.type == TextureType::CUBE_MAP);
+
+        auto level_size = glm::uvec2(std::max(texture.size.x >> level, 1u), std::max(texture.size.y >> level, 1u));
+        auto bytes      = size_t{level_size.x} * level_size.y * get_pixel_size(texture.color, texture.data);
+        GLOW_ASSERT(bytes <= slot_size);
+
+        auto index = begin_read();
+        texture.read_level(GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(face), level, reinterpret_cast<void*>(index * slot_size));
+        end_read(index, bytes, std::move(callback));
+    }
+
+    size_t PixelReader::poll() noexcept
+    {
+        while (!requests.empty())
+        {
+            auto fence  = static_cast<GLsync>(requests.front().fence);
+            auto result = glClientWaitSync(fence, 0, 0);
+            GLOW_ASSERT(result != GL_WAIT_FAILED);
+            if (result == GL_TIMEOUT_EXPIRED)
+            {
+                break;
+            }
+
+            complete(requests.front());
+            requests.pop_front();
+        }
+
+        return requests.size();
+    }
+
+    void PixelReader::wait_all() noexcept
+    {
+        while (!requests.empty())
+        {
+            complete(requests.front());
+            requests.pop_front();
+        }
+    }
+
+    unsigned int PixelReader::begin_read() noexcept
+    {
+        GLOW_ASSERT(glid != 0);
+
+        // the slots are used in order, so the oldest read holds the next slot
+        if (requests.size() == slot_count)
+        {
+            complete(requests.front());
+            requests.pop_front();
+        }
+
+        auto slot = next_slot;
+        next_slot = (next_slot + 1u) % slot_count;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, glid);
+        return slot;
+    }
+
+    void PixelReader::end_read(unsigned int slot, size_t size, ReadCallback callback) noexcept
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        requests.push_back({slot, size, fence, std::move(callback)});
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void PixelReader::complete(Request& request) noexcept
+    {
+        auto fence  = static_cast<GLsync>(request.fence);
+        auto result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, READ_TIMEOUT);
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, READ_TIMEOUT);
+        }
+        GLOW_ASSERT(result != GL_WAIT_FAILED);
+        glDeleteSync(fence);
+        request.fence = nullptr;
+
+        auto offset = request.slot * slot_size;
+        if (persistent)
+        {
+            // the mapping is coherent, the fence makes the data visible
+            request.callback(memory + offset, request.size);
+        }
+        else
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, glid);
+            auto data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, offset, request.size, GL_MAP_READ_BIT);
+            GLOW_ASSERT(data != nullptr);
+            request.callback(data, request.size);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+}
@@ -0,0 +1,154 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <vector>
+
+#include "defines.h"
+#include "Texture.h"
+
+namespace glow
+{
+    class FrameBuffer;
+
+    //! Callback receiving the pixels of a completed read.
+    //!
+    //! The data is only valid during the call.
+    using ReadCallback = std::function<void (const void* data, size_t size)>;
+
+    //! Pixel Reader
+    //!
+    //! The pixel reader reads pixels back from frame buffers and textures
+    //! without stalling the pipeline. Each read is copied into a slot of
+    //! a pixel pack buffer ring and fenced. poll hands the data of
+    //! completed reads to their callback or future, so the readback of
+    //! one frame overlaps with rendering the next.
+    //!
+    //! If all slots are in use, the oldest read is waited for.
+    //!
+    //! If OpenGL 4.4 or ARB_buffer_storage is available the ring is
+    //! persistently mapped, otherwise each slot is mapped on completion.
+    class GLOW_EXPORT PixelReader
+    {
+    public:
+        //! Create a pixel reader.
+        //!
+        //! @param slot_size the size of the largest read in bytes
+        //! @param slot_count the number of reads in flight
+        PixelReader(size_t slot_size, unsigned int slot_count = 3u);
+
+        //! Release pixel reader.
+        //!
+        //! Completes all pending reads.
+        ~PixelReader();
+
+        //! Check if the ring is persistently mapped.
+        bool is_persistent() const noexcept;
+
+        //! Get the size of a slot in bytes.
+        //!
+        //! The slot size is rounded up to a multiple of 16 bytes.
+        size_t get_slot_size() const noexcept;
+
+        //! Get the number of reads in flight.
+        size_t get_pending() const noexcept;
+
+        //! Read pixels from a frame buffer color buffer.
+        //!
+        //! @param buffer the frame buffer to read from
+        //! @param slot the color buffer slot
+        //! @param offset the offset of the region in pixels
+        //! @param size the size of the region in pixels
+        //! @param color the color mode to read
+        //! @param data the data type to read
+        //! @param callback called from poll with the pixels
+        void read_pixels(FrameBuffer& buffer, unsigned int slot, glm::uvec2 offset, glm::uvec2 size, ColorMode color, DataType data, ReadCallback callback) noexcept;
+
+        //! Read pixels from a frame buffer color buffer.
+        //!
+        //! @param buffer the frame buffer to read from
+        //! @param slot the color buffer slot
+        //! @param offset the offset of the region in pixels
+        //! @param size the size of the region in pixels
+        //! @param color the color mode to read
+        //! @param data the data type to read
+        //! @return the pixels, ready after poll completed the read
+        std::future<std::vector<std::byte>> read_pixels(FrameBuffer& buffer, unsigned int slot, glm::uvec2 offset, glm::uvec2 size, ColorMode color, DataType data) noexcept;
+
+        //! Read a level of a 2D texture.
+        //!
+        //! @param texture the texture to read from
+        //! @param level the mipmap level
+        //! @param callback called from poll with the pixels
+        void read_pixels(Texture& texture, int level, ReadCallback callback) noexcept;
+
+        //! Read a level of a 2D texture.
+        //!
+        //! @param texture the texture to read from
+        //! @param level the mipmap level
+        //! @return the pixels, ready after poll completed the read
+        std::future<std::vector<std::byte>> read_pixels(Texture& texture, int level = 0) noexcept;
+
+        //! Read a level of a cube map face.
+        //!
+        //! @param texture the texture to read from
+        //! @param face the cube map face
+        //! @param level the mipmap level
+        //! @param callback called from poll with the pixels
+        void read_pixels(Texture& texture, CubeFace face, int level, ReadCallback callback) noexcept;
+
+        //! Complete all finished reads.
+        //!
+        //! @return the number of reads still in flight
+        size_t poll() noexcept;
+
+        //! Wait for and complete all reads.
+        void wait_all() noexcept;
+
+    private:
+        struct Request
+        {
+            unsigned int slot     = 0u;
+            size_t       size     = 0u;
+            void*        fence    = nullptr;
+            ReadCallback callback;
+        };
+
+        glm::uint           glid       = 0u;
+        std::byte*          memory     = nullptr;
+        size_t              slot_size  = 0u;
+        unsigned int        slot_count = 0u;
+        unsigned int        next_slot  = 0u;
+        bool                persistent = false;
+        std::deque<Request> requests;
+
+        unsigned int begin_read() noexcept;
+        void end_read(unsigned int slot, size_t size, ReadCallback callback) noexcept;
+        void complete(Request& request) noexcept;
+
+        PixelReader(const PixelReader&) = delete;
+        PixelReader& operator = (const PixelReader&) = delete;
+    };
+}
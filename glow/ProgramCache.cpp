@@ -0,0 +1,269 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "ProgramCache.h"
+#include "util.h"
+
+#include <fstream>
+
+namespace glow
+{
+    constexpr auto CACHE_MAGIC = std::array<char, 8>{'G', 'L', 'O', 'W', 'P', 'R', 'G', '1'};
+
+    struct CacheHeader
+    {
+        std::array<char, 8> magic;
+        std::uint64_t       key;
+        std::uint32_t       format;
+        std::uint32_t       length;
+    };
+
+    constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+    constexpr std::uint64_t FNV_PRIME  = 1099511628211ull;
+
+    constexpr std::uint64_t fnv1a(std::uint64_t hash, std::string_view data) noexcept
+    {
+        for (auto c : data)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    std::string get_gl_string(GLenum name)
+    {
+        auto value = reinterpret_cast<const char*>(glGetString(name));
+        return value != nullptr ? std::string{value} : std::string{};
+    }
+
+    ProgramCache::ProgramCache(const std::filesystem::path& d)
+    : directory(d)
+    {
+        std::filesystem::create_directories(directory);
+
+        driver = get_gl_string(GL_VENDOR) + "\n" +
+                 get_gl_string(GL_RENDERER) + "\n" +
+                 get_gl_string(GL_VERSION);
+
+        auto count = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+        supported = count > 0;
+        if (supported)
+        {
+            formats.resize(static_cast<size_t>(count));
+            glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, reinterpret_cast<GLint*>(formats.data()));
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    const std::filesystem::path& ProgramCache::get_directory() const noexcept
+    {
+        return directory;
+    }
+
+    bool ProgramCache::is_supported() const noexcept
+    {
+        return supported;
+    }
+
+    unsigned int ProgramCache::get_hits() const noexcept
+    {
+        return hits;
+    }
+
+    unsigned int ProgramCache::get_misses() const noexcept
+    {
+        return misses;
+    }
+
+    unsigned int ProgramCache::get_invalidations() const noexcept
+    {
+        return invalidations;
+    }
+
+    void ProgramCache::clear() noexcept
+    {
+        auto ec = std::error_code{};
+        for (const auto& entry : std::filesystem::directory_iterator(directory, ec))
+        {
+            if (entry.path().extension() == ".bin")
+            {
+                std::filesystem::remove(entry.path(), ec);
+            }
+        }
+    }
+
+    std::uint64_t ProgramCache::get_key(std::initializer_list<std::string_view> sources) const noexcept
+    {
+        auto hash = fnv1a(FNV_OFFSET, driver);
+        for (const auto& source : sources)
+        {
+            // the terminator keeps ("ab", "c") and ("a", "bc") apart
+            hash = fnv1a(hash, source);
+            hash = fnv1a(hash, std::string_view{"\0", 1});
+        }
+        return hash;
+    }
+
+    std::filesystem::path ProgramCache::get_path(std::uint64_t key) const noexcept
+    {
+        constexpr auto digits = "0123456789abcdef";
+
+        auto name = std::string(16, '0');
+        for (auto i = 0; i < 16; i++)
+        {
+            name[15 - i] = digits[(key >> (i * 4)) & 0xF];
+        }
+
+        return directory / (name + ".bin");
+    }
+
+    unsigned int ProgramCache::load(std::uint64_t key) noexcept
+    {
+        if (!supported)
+        {
+            misses++;
+            return 0u;
+        }
+
+        auto path = get_path(key);
+        auto file = std::ifstream(path, std::ios::binary);
+        if (!file)
+        {
+            misses++;
+            return 0u;
+        }
+
+        auto header = CacheHeader{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        // the length must match the file, so a corrupt header can't request a huge allocation
+        auto ec        = std::error_code{};
+        auto file_size = std::filesystem::file_size(path, ec);
+        auto complete  = !ec && file_size >= sizeof(header) && file_size - sizeof(header) == header.length;
+
+        auto binary = std::vector<char>();
+        if (file && complete && header.magic == CACHE_MAGIC && header.key == key)
+        {
+            binary.resize(header.length);
+            file.read(binary.data(), binary.size());
+        }
+        auto valid = file.good() && !binary.empty() &&
+                     std::find(begin(formats), end(formats), header.format) != end(formats);
+        file.close();
+
+        auto program = 0u;
+        if (valid)
+        {
+            program = glCreateProgram();
+
+            // a rejected binary is expected, don't report it as error
+            auto muted = is_debug_output();
+            if (muted)
+            {
+                glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, "ProgramCache::load");
+                glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_ERROR, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+            }
+
+            glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+            auto status = 0;
+            glGetProgramiv(program, GL_LINK_STATUS, &status);
+
+            // popping the group restores the message filter
+            if (muted)
+            {
+                glPopDebugGroup();
+            }
+
+            if (!status)
+            {
+                glDeleteProgram(program);
+                program = 0u;
+
+                // a rejected binary sets GL_INVALID_ENUM on some drivers
+                clear_errors();
+            }
+        }
+
+        if (program == 0u)
+        {
+            std::filesystem::remove(path, ec);
+            invalidations++;
+            misses++;
+            return 0u;
+        }
+
+        hits++;
+        return program;
+    }
+
+    void ProgramCache::store(std::uint64_t key, unsigned int program) noexcept
+    {
+        GLOW_ASSERT(program != 0);
+
+        if (!supported)
+        {
+            return;
+        }
+
+        auto length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+        {
+            return;
+        }
+
+        auto header   = CacheHeader{CACHE_MAGIC, key, 0u, 0u};
+        auto binary   = std::vector<char>(static_cast<size_t>(length));
+        auto received = GLsizei{0};
+        auto format   = GLenum{0};
+        glGetProgramBinary(program, length, &received, &format, binary.data());
+        GLOW_CHECK_GLERROR();
+
+        header.format = format;
+        header.length = static_cast<std::uint32_t>(received);
+
+        // write to a temporary file first, so that concurrent processes
+        // never see a partial entry
+        auto path = get_path(key);
+        auto temp = path;
+        temp += ".tmp";
+        {
+            auto file = std::ofstream(temp, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), received);
+            if (!file)
+            {
+                file.close();
+                auto ec = std::error_code{};
+                std::filesystem::remove(temp, ec);
+                return;
+            }
+        }
+
+        auto ec = std::error_code{};
+        std::filesystem::rename(temp, path, ec);
+    }
+}
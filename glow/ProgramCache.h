@@ -0,0 +1,94 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "defines.h"
+
+namespace glow
+{
+    //! Program Binary Cache
+    //!
+    //! The program cache stores linked shader programs on disk with
+    //! glGetProgramBinary and restores them with glProgramBinary. Entries
+    //! are keyed by the shader code and the OpenGL vendor, renderer and
+    //! version strings, so a driver update invalidates the cache. Entries
+    //! the driver rejects are removed and the shader is compiled from
+    //! source.
+    //!
+    //! The cache is opt in, pass it to Shader::compile.
+    //!
+    //! @note The cache must be created with a current OpenGL context.
+    class GLOW_EXPORT ProgramCache
+    {
+    public:
+        //! Create a cache.
+        //!
+        //! @param directory the directory the binaries are stored in
+        ProgramCache(const std::filesystem::path& directory);
+
+        //! Get the cache directory.
+        const std::filesystem::path& get_directory() const noexcept;
+
+        //! Check if the driver supports program binaries.
+        bool is_supported() const noexcept;
+
+        //! Get the number of programs loaded from the cache.
+        unsigned int get_hits() const noexcept;
+
+        //! Get the number of programs not found in the cache.
+        //!
+        //! @note Invalidated entries also count as miss.
+        unsigned int get_misses() const noexcept;
+
+        //! Get the number of entries rejected by the driver.
+        unsigned int get_invalidations() const noexcept;
+
+        //! Remove all entries from the cache.
+        void clear() noexcept;
+
+    private:
+        std::filesystem::path     directory;
+        std::string               driver;
+        bool                      supported     = false;
+        std::vector<unsigned int> formats;
+        unsigned int              hits          = 0u;
+        unsigned int              misses        = 0u;
+        unsigned int              invalidations = 0u;
+
+        std::uint64_t get_key(std::initializer_list<std::string_view> sources) const noexcept;
+        std::filesystem::path get_path(std::uint64_t key) const noexcept;
+        unsigned int load(std::uint64_t key) noexcept;
+        void store(std::uint64_t key, unsigned int program) noexcept;
+
+        ProgramCache(const ProgramCache&) = delete;
+        ProgramCache& operator = (const ProgramCache&) = delete;
+
+    friend class Shader;
+    };
+}
@@ -0,0 +1,137 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "Sampler.h"
+#include "StateCache.h"
+#include "util.h"
+
+#include <memory>
+#include <unordered_map>
+
+namespace glow
+{
+    std::unordered_map<SamplerDesc, std::unique_ptr<Sampler>>& get_sampler_cache() noexcept
+    {
+        static auto cache = std::unordered_map<SamplerDesc, std::unique_ptr<Sampler>>{};
+        return cache;
+    }
+
+    GLint get_min_filter(const SamplerDesc& desc) noexcept
+    {
+        switch (desc.filter)
+        {
+        case FilterMode::LINEAR:
+            return desc.mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+        case FilterMode::NEAREST:
+            return desc.mipmaps ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST;
+        default:
+            GLOW_FAIL("Unknown filter mode.");
+            return GL_LINEAR;
+        }
+    }
+
+    Sampler::Sampler(const SamplerDesc& d)
+    : desc(d)
+    {
+        glGenSamplers(1, &glid);
+
+        auto wrap = desc.wrap == WrapMode::CLAMP ? GL_CLAMP_TO_EDGE : GL_REPEAT;
+        glSamplerParameteri(glid, GL_TEXTURE_MIN_FILTER, get_min_filter(desc));
+        glSamplerParameteri(glid, GL_TEXTURE_MAG_FILTER, desc.filter == FilterMode::LINEAR ? GL_LINEAR : GL_NEAREST);
+        glSamplerParameteri(glid, GL_TEXTURE_WRAP_S, wrap);
+        glSamplerParameteri(glid, GL_TEXTURE_WRAP_T, wrap);
+        glSamplerParameteri(glid, GL_TEXTURE_WRAP_R, wrap);
+
+        if (desc.compare)
+        {
+            glSamplerParameteri(glid, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+            glSamplerParameteri(glid, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+        }
+
+        if (desc.anisotropy > 1.0f)
+        {
+            auto max_anisotropy = get_max_anisotropy();
+            if (max_anisotropy > 1.0f)
+            {
+                glSamplerParameterf(glid, GL_TEXTURE_MAX_ANISOTROPY_EXT, std::min(desc.anisotropy, max_anisotropy));
+            }
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    Sampler::~Sampler()
+    {
+        if (glid != 0)
+        {
+            StateCache::get().release_sampler(glid);
+            glDeleteSamplers(1, &glid);
+            glid = 0;
+            GLOW_CHECK_GLERROR();
+        }
+    }
+
+    const Sampler& Sampler::get(const SamplerDesc& desc)
+    {
+        auto& cache = get_sampler_cache();
+        auto i = cache.find(desc);
+        if (i == end(cache))
+        {
+            i = cache.emplace(desc, std::make_unique<Sampler>(desc)).first;
+        }
+        return *i->second;
+    }
+
+    void Sampler::clear_cache() noexcept
+    {
+        get_sampler_cache().clear();
+    }
+
+    float Sampler::get_max_anisotropy() noexcept
+    {
+        if (!GLEW_EXT_texture_filter_anisotropic && !GLEW_ARB_texture_filter_anisotropic)
+        {
+            return 1.0f;
+        }
+
+        auto value = 1.0f;
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &value);
+        return value;
+    }
+
+    const SamplerDesc& Sampler::get_desc() const noexcept
+    {
+        return desc;
+    }
+
+    void Sampler::bind(glm::uint slot) const noexcept
+    {
+        GLOW_ASSERT(glid != 0);
+        StateCache::get().bind_sampler(slot, glid);
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Sampler::unbind(glm::uint slot) noexcept
+    {
+        StateCache::get().bind_sampler(slot, 0);
+    }
+}
@@ -0,0 +1,123 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <functional>
+
+#include "defines.h"
+#include "Texture.h"
+
+namespace glow
+{
+    //! Sampler Description
+    //!
+    //! All state of a sampler. Equal descriptions yield the same
+    //! sampler through Sampler::get.
+    struct SamplerDesc
+    {
+        //! The filter mode.
+        FilterMode filter     = FilterMode::LINEAR;
+        //! Filter between mipmap levels.
+        //!
+        //! The texture samples only the levels up to its maximum level,
+        //! which for upload_2d and upload_cube is the base level until
+        //! generate_mipmaps is called.
+        bool       mipmaps    = true;
+        //! The wrapping mode.
+        WrapMode   wrap       = WrapMode::REPEAT;
+        //! The maximum anisotropy, 1 disables anisotropic filtering.
+        float      anisotropy = 1.0f;
+        //! Compare against the reference value for shadow maps.
+        bool       compare    = false;
+
+        bool operator == (const SamplerDesc&) const noexcept = default;
+    };
+
+    //! Sampler
+    //!
+    //! A sampler object holds filter and wrap state independent of any
+    //! texture. Binding a sampler to a slot overrides the state of the
+    //! texture bound to the same slot, so one texture can be sampled in
+    //! different ways and textures need not carry their own state.
+    class GLOW_EXPORT Sampler
+    {
+    public:
+        //! Create a sampler.
+        //!
+        //! @param desc the sampler state
+        Sampler(const SamplerDesc& desc = {});
+
+        //! Release sampler.
+        ~Sampler();
+
+        //! Get a shared sampler for a description.
+        //!
+        //! Samplers are cached globally, so equal descriptions share
+        //! one sampler object.
+        //!
+        //! @param desc the sampler state
+        //! @return the cached sampler
+        static const Sampler& get(const SamplerDesc& desc);
+
+        //! Release all cached samplers.
+        //!
+        //! @note This must be called before the context is destroyed.
+        static void clear_cache() noexcept;
+
+        //! Get the maximum anisotropy supported.
+        static float get_max_anisotropy() noexcept;
+
+        //! Get the sampler state.
+        const SamplerDesc& get_desc() const noexcept;
+
+        //! Bind the sampler to a texture slot.
+        //!
+        //! @param slot the texture slot
+        void bind(glm::uint slot) const noexcept;
+
+        //! Unbind the sampler from a texture slot.
+        //!
+        //! @param slot the texture slot
+        static void unbind(glm::uint slot) noexcept;
+
+    private:
+        glm::uint   glid = 0u;
+        SamplerDesc desc;
+
+        Sampler(const Sampler&) = delete;
+        Sampler& operator = (const Sampler&) = delete;
+    };
+}
+
+template <>
+struct std::hash<glow::SamplerDesc>
+{
+    size_t operator () (const glow::SamplerDesc& desc) const noexcept
+    {
+        auto hash = std::hash<float>{}(desc.anisotropy);
+        hash ^= static_cast<size_t>(desc.filter) << 1u;
+        hash ^= static_cast<size_t>(desc.wrap) << 3u;
+        hash ^= static_cast<size_t>(desc.mipmaps) << 5u;
+        hash ^= static_cast<size_t>(desc.compare) << 6u;
+        return hash;
+    }
+};
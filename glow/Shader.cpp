@@ -21,6 +21,8 @@
 
 #include "pch.h"
 #include "Shader.h"
+#include "Sampler.h"
+#include "StateCache.h"
 #include "util.h"
 
 using namespace std::string_view_literals;
@@ -37,17 +39,35 @@ namespace glow
     constexpr auto FRAGMENT_PREFIX =
         "#define GLOW_FRAGMENT\n";
 
+    constexpr auto BINDLESS_PREFIX =
+        "#extension GL_ARB_bindless_texture : require\n"
+        "#define GLOW_BINDLESS\n";
+
+    const char* get_feature_prefix() noexcept
+    {
+        return GLEW_ARB_bindless_texture ? BINDLESS_PREFIX : "";
+    }
+
     Shader::Shader(const std::string& c)
     : code(c)
     {
         compile();
     }
 
+    Shader::Shader(const std::string& c, ProgramCache& cache)
+    : code(c)
+    {
+        compile(cache);
+    }
+
     Shader::~Shader()
     {
+        release_stages();
+
         if (program_id != 0)
         {
             glDeleteProgram(program_id);
+            StateCache::get().release_program(program_id);
             program_id = 0;
             GLOW_CHECK_GLERROR();
         }
@@ -65,69 +85,176 @@ namespace glow
 
     void Shader::compile()
     {
-        GLOW_ASSERT(program_id == 0);
+        begin_compile(nullptr);
+        end_compile(nullptr);
+    }
 
-        auto status = 0;
-        auto logstr = std::array<char, 256>();
+    void Shader::compile(ProgramCache& cache)
+    {
+        if (!begin_compile(&cache))
+        {
+            end_compile(&cache);
+        }
+    }
+
+    bool Shader::begin_compile(ProgramCache* cache)
+    {
+        GLOW_DEBUG_GROUP("Shader::begin_compile");
+        GLOW_ASSERT(program_id == 0);
+        GLOW_ASSERT(vertex_id == 0 && fragment_id == 0);
 
-        auto vbuff = std::array<const char*, 3>{CODE_PREFIX, VERTEX_PREFIX, code.data()};
+        if (cache != nullptr)
+        {
+            auto key = cache->get_key({CODE_PREFIX, get_feature_prefix(), VERTEX_PREFIX, FRAGMENT_PREFIX, code});
+            program_id = cache->load(key);
+            if (program_id != 0)
+            {
+                load_uniforms();
+                load_attributes();
+                return true;
+            }
+        }
 
-        unsigned int vertex_id = glCreateShader(GL_VERTEX_SHADER);
+        // NOTE: No status is queried here, so that drivers implementing
+        // KHR_parallel_shader_compile can compile and link in the background.
+        auto vbuff = std::array<const char*, 4>{CODE_PREFIX, get_feature_prefix(), VERTEX_PREFIX, code.data()};
+        vertex_id = glCreateShader(GL_VERTEX_SHADER);
         glShaderSource(vertex_id, static_cast<GLsizei>(vbuff.size()), vbuff.data(), NULL);
         glCompileShader(vertex_id);
 
-        glGetShaderInfoLog(vertex_id, static_cast<GLsizei>(logstr.size()), NULL, logstr.data());
+        auto fbuff = std::array<const char*, 4>{CODE_PREFIX, get_feature_prefix(), FRAGMENT_PREFIX, code.data()};
+        fragment_id = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(fragment_id,  static_cast<GLsizei>(fbuff.size()), fbuff.data(), NULL);
+        glCompileShader(fragment_id);
 
-        glGetShaderiv(vertex_id, GL_COMPILE_STATUS, &status);
-        if (!status)
+        program_id = glCreateProgram();
+        if (cache != nullptr && cache->is_supported())
         {
-            glDeleteShader(vertex_id);
-            throw std::runtime_error(logstr.data());
+            glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
         }
+        glBindAttribLocation(program_id, VERTEX_LOCATION,   VERTEX);
+        glBindAttribLocation(program_id, NORMAL_LOCATION,   NORMAL);
+        glBindAttribLocation(program_id, TANGENT_LOCATION,  TANGENT);
+        glBindAttribLocation(program_id, TEXCOORD_LOCATION, TEXCOORD);
+        glAttachShader(program_id, vertex_id);
+        glAttachShader(program_id, fragment_id);
+        glLinkProgram(program_id);
 
         GLOW_CHECK_GLERROR();
+        return false;
+    }
 
-        auto fbuff = std::array<const char*, 3>{CODE_PREFIX, FRAGMENT_PREFIX, code.data()};
+    bool Shader::is_compile_complete() const noexcept
+    {
+        GLOW_ASSERT(program_id != 0);
 
-        unsigned int fragment_id = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment_id,  static_cast<GLsizei>(fbuff.size()), fbuff.data(), NULL);
-        glCompileShader(fragment_id);
+        if (!GLEW_KHR_parallel_shader_compile && !GLEW_ARB_parallel_shader_compile)
+        {
+            return true;
+        }
+
+        auto status = 0;
+        glGetProgramiv(program_id, GL_COMPLETION_STATUS_KHR, &status);
+        return status != 0;
+    }
+
+    void Shader::end_compile(ProgramCache* cache)
+    {
+        GLOW_DEBUG_GROUP("Shader::end_compile");
+        GLOW_ASSERT(program_id != 0);
+        GLOW_ASSERT(vertex_id != 0 && fragment_id != 0);
+
+        auto status = 0;
+        auto logstr = std::array<char, 256>();
 
-        glGetShaderInfoLog(fragment_id, static_cast<GLsizei>(logstr.size()), NULL, logstr.data());
+        auto fail = [&] () {
+            release_stages();
+            glDeleteProgram(program_id);
+            program_id = 0;
+            throw std::runtime_error(logstr.data());
+        };
 
-        glGetShaderiv(fragment_id, GL_COMPILE_STATUS, &status);
+        for (auto stage_id : {vertex_id, fragment_id})
+        {
+            glGetShaderiv(stage_id, GL_COMPILE_STATUS, &status);
+            if (!status)
+            {
+                glGetShaderInfoLog(stage_id, static_cast<GLsizei>(logstr.size()), NULL, logstr.data());
+                fail();
+            }
+        }
+
+        glGetProgramiv(program_id, GL_LINK_STATUS, &status);
         if (!status)
         {
-            glDeleteShader(vertex_id);
-            glDeleteShader(fragment_id);
-            throw std::runtime_error(logstr.data());
+            glGetProgramInfoLog(program_id, static_cast<GLsizei>(logstr.size()), NULL, logstr.data());
+            fail();
         }
 
+        release_stages();
         GLOW_CHECK_GLERROR();
 
-        program_id = glCreateProgram();
-        glAttachShader(program_id, vertex_id);
-        assert(glGetError() == GL_NO_ERROR);
-        glAttachShader(program_id, fragment_id);
-        assert(glGetError() == GL_NO_ERROR);
-        glLinkProgram(program_id);
+        load_uniforms();
+        load_attributes();
 
-        glGetShaderInfoLog(vertex_id,  static_cast<GLsizei>(logstr.size()), NULL, logstr.data());
-
-        glGetProgramiv(program_id, GL_LINK_STATUS, &status);
-        if (!status)
+        if (cache != nullptr)
         {
-            glDeleteShader(vertex_id);
-            glDeleteShader(fragment_id);
-            glDeleteProgram(program_id);
-            throw std::runtime_error(logstr.data());
+            auto key = cache->get_key({CODE_PREFIX, get_feature_prefix(), VERTEX_PREFIX, FRAGMENT_PREFIX, code});
+            cache->store(key, program_id);
         }
+    }
 
+    void Shader::release_stages() noexcept
+    {
         // NOTE: glDeleteShader() actually does not delete the shader, it only
         // flags the shader for deletion. The shaders will be deleted when
         // the program gets deleted.
-        glDeleteShader(vertex_id);
-        glDeleteShader(fragment_id);
+        if (vertex_id != 0)
+        {
+            glDeleteShader(vertex_id);
+            vertex_id = 0;
+        }
+        if (fragment_id != 0)
+        {
+            glDeleteShader(fragment_id);
+            fragment_id = 0;
+        }
+    }
+
+    void Shader::load_uniforms()
+    {
+        GLOW_ASSERT(program_id != 0);
+
+        uniform_locations.clear();
+
+        auto count  = 0;
+        auto length = 0;
+        glGetProgramiv(program_id, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(program_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &length);
+
+        auto name = std::string(static_cast<size_t>(length), '\0');
+        for (auto i = 0; i < count; i++)
+        {
+            auto name_length = GLsizei{0};
+            auto size        = GLint{0};
+            auto type        = GLenum{0};
+            glGetActiveUniform(program_id, i, length, &name_length, &size, &type, name.data());
+
+            auto uname    = std::string(name.data(), static_cast<size_t>(name_length));
+            auto location = glGetUniformLocation(program_id, uname.data());
+            if (location == -1)
+            {
+                // members of uniform blocks have no location
+                continue;
+            }
+
+            // arrays are reported as "name[0]", but may be addressed as "name"
+            if (uname.ends_with("[0]"))
+            {
+                uniform_locations[uname.substr(0, uname.size() - 3)] = location;
+            }
+            uniform_locations[std::move(uname)] = location;
+        }
 
         GLOW_CHECK_GLERROR();
     }
@@ -135,20 +262,25 @@ namespace glow
     void Shader::bind() noexcept
     {
         GLOW_ASSERT(program_id != 0);
-        glUseProgram(program_id);
+        StateCache::get().use_program(program_id);
         GLOW_CHECK_GLERROR();
     }
 
     void Shader::unbind() noexcept
     {
-        glUseProgram(0);
+        StateCache::get().use_program(0);
         GLOW_CHECK_GLERROR();
     }
 
     void Shader::set_uniform(const std::string_view id, const UniformValue& value) noexcept
+    {
+        set_uniform(get_uniform(id), value);
+    }
+
+    void Shader::set_uniform(UniformHandle handle, const UniformValue& value) noexcept
     {
         GLOW_ASSERT(program_id != 0);
-        if (int location = glGetUniformLocation(program_id, id.data()); location != -1)
+        if (auto location = handle.location; location != -1)
         {
             std::visit(overloaded {
             [&] (bool v)         { glUniform1i(location, v); },
@@ -171,13 +303,100 @@ namespace glow
         }
     }
 
+    void Shader::load_attributes()
+    {
+        GLOW_ASSERT(program_id != 0);
+
+        attribute_locations.clear();
+
+        auto count  = 0;
+        auto length = 0;
+        glGetProgramiv(program_id, GL_ACTIVE_ATTRIBUTES, &count);
+        glGetProgramiv(program_id, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &length);
+
+        auto attributes = std::vector<std::pair<std::string, int>>();
+        auto name = std::string(static_cast<size_t>(length), '\0');
+        for (auto i = 0; i < count; i++)
+        {
+            auto name_length = GLsizei{0};
+            auto size        = GLint{0};
+            auto type        = GLenum{0};
+            glGetActiveAttrib(program_id, i, length, &name_length, &size, &type, name.data());
+
+            auto aname    = std::string(name.data(), static_cast<size_t>(name_length));
+            auto location = glGetAttribLocation(program_id, aname.data());
+            if (location == -1)
+            {
+                // built in attributes, such as gl_VertexID
+                continue;
+            }
+
+            attributes.emplace_back(aname, location);
+            attribute_locations[std::move(aname)] = location;
+        }
+
+        // the enumeration order is implementation defined
+        std::sort(begin(attributes), end(attributes));
+
+        auto hash = size_t{0u};
+        for (const auto& [aname, location] : attributes)
+        {
+            hash ^= std::hash<std::string>{}(aname) + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<int>{}(location) + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+        }
+        // 0 means no interface
+        attribute_interface = hash != 0u ? hash : 1u;
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    UniformHandle Shader::get_uniform(const std::string_view name) noexcept
+    {
+        GLOW_ASSERT(program_id != 0);
+
+        if (auto i = uniform_locations.find(name); i != end(uniform_locations))
+        {
+            return {i->second};
+        }
+
+        // Only elements of arrays beyond the first are not enumerated,
+        // everything else is simply not an active uniform.
+        if (name.find('[') == std::string_view::npos)
+        {
+            return {};
+        }
+
+        auto sname    = std::string{name};
+        auto location = glGetUniformLocation(program_id, sname.data());
+        GLOW_CHECK_GLERROR();
+        uniform_locations[std::move(sname)] = location;
+        return {location};
+    }
+
     void Shader::set_uniform(const std::string_view name, Texture& texture) noexcept
     {
+        if (texture.is_resident())
+        {
+            if (auto handle = get_uniform(name); handle.is_valid())
+            {
+                glUniformHandleui64ARB(handle.location, texture.get_handle());
+                GLOW_CHECK_GLERROR();
+            }
+            return;
+        }
+
         auto slot = get_texture_slot(name);
         texture.bind(slot);
         set_uniform(name, slot);
     }
 
+    void Shader::set_uniform(const std::string_view name, Texture& texture, const Sampler& sampler) noexcept
+    {
+        auto slot = get_texture_slot(name);
+        texture.bind(slot, sampler);
+        set_uniform(name, slot);
+    }
+
     uint Shader::get_texture_slot(const std::string_view name) noexcept
     {
         if (auto i = texture_slots.find(name); i != end(texture_slots))
@@ -192,12 +411,19 @@ namespace glow
         return slot;
     }
 
-    int Shader::get_attribute(const std::string_view name) noexcept
+    int Shader::get_attribute(const std::string_view name) const noexcept
     {
         GLOW_ASSERT(program_id != 0);
-        auto id = glGetAttribLocation(program_id, name.data());
-        GLOW_CHECK_GLERROR();
-        return id;
+        if (auto i = attribute_locations.find(name); i != end(attribute_locations))
+        {
+            return i->second;
+        }
+        return -1;
+    }
+
+    size_t Shader::get_attribute_interface() const noexcept
+    {
+        return attribute_interface;
     }
 
     void Shader::bind_output(const std::string_view name, uint channel) noexcept
@@ -207,4 +433,28 @@ namespace glow
         GLOW_CHECK_GLERROR();
     }
 
+    void Shader::bind_uniform_block(const std::string_view name, uint binding) noexcept
+    {
+        GLOW_ASSERT(program_id != 0);
+        auto sname = std::string{name};
+        auto index = glGetUniformBlockIndex(program_id, sname.data());
+        if (index != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(program_id, index, binding);
+        }
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Shader::bind_storage_block(const std::string_view name, uint binding) noexcept
+    {
+        GLOW_ASSERT(program_id != 0);
+        auto sname = std::string{name};
+        auto index = glGetProgramResourceIndex(program_id, GL_SHADER_STORAGE_BLOCK, sname.data());
+        if (index != GL_INVALID_INDEX)
+        {
+            glShaderStorageBlockBinding(program_id, index, binding);
+        }
+        GLOW_CHECK_GLERROR();
+    }
+
 }
@@ -25,13 +25,37 @@
 #include <string_view>
 #include <variant>
 #include <map>
+#include <unordered_map>
 #include <glm/glm.hpp>
 
 #include "defines.h"
+#include "util.h"
 #include "Texture.h"
+#include "ProgramCache.h"
 
 namespace glow
 {
+    //! Standard attribute names.
+    //!
+    //! Shaders bind these attributes to fixed locations, so that vertex
+    //! buffers can be used with any shader without reconfiguration.
+    //!
+    //! @{
+    constexpr auto VERTEX   = "glow_Vertex";
+    constexpr auto NORMAL   = "glow_Normal";
+    constexpr auto TANGENT  = "glow_Tangent";
+    constexpr auto TEXCOORD = "glow_TexCoord";
+    //! @}
+
+    //! Standard attribute locations.
+    //!
+    //! @{
+    constexpr auto VERTEX_LOCATION   = 0u;
+    constexpr auto NORMAL_LOCATION   = 1u;
+    constexpr auto TANGENT_LOCATION  = 2u;
+    constexpr auto TEXCOORD_LOCATION = 3u;
+    //! @}
+
 	//! All accepted uniform variable types.
     using UniformValue = std::variant<bool, int, uint, float,
                                       ivec2, uvec2, vec2,
@@ -39,6 +63,21 @@ namespace glow
                                       ivec4, uvec4, vec4,
                                       mat2,  mat3,  mat4>;
 
+    //! Resolved uniform variable.
+    //!
+    //! A uniform handle is obtained once through Shader::get_uniform and
+    //! can then be used to set the value without any name lookup.
+    struct UniformHandle
+    {
+        int location = -1;
+
+        //! Check if the handle refers to an active uniform.
+        bool is_valid() const noexcept
+        {
+            return location != -1;
+        }
+    };
+
     //! GLSL Shader
     class GLOW_EXPORT Shader
     {
@@ -46,6 +85,8 @@ namespace glow
         Shader() noexcept = default;
         //! Create shader from code and compile it
         Shader(const std::string& code);
+        //! Create shader from code and compile it using a program cache
+        Shader(const std::string& code, ProgramCache& cache);
         ~Shader();
 
         //! Shader Code
@@ -57,6 +98,8 @@ namespace glow
         //! * GLOW_VERTEX: vertex program
         //! * GLOW_FRAGMENT: fragment program
         //!
+        //! GLOW_BINDLESS is defined when ARB_bindless_texture is available.
+        //!
         //! @{
         void set_code(const std::string& value) noexcept;
         const std::string& get_code() const noexcept;
@@ -65,6 +108,11 @@ namespace glow
         //! Compile the shader.
         void compile();
 
+        //! Compile the shader or load it from the program cache.
+        //!
+        //! @param cache the program cache to use
+        void compile(ProgramCache& cache);
+
         //! Bind the shader.
         //!
         //! @note the shader must be compiled.
@@ -82,23 +130,59 @@ namespace glow
         //! and then bind the slot as uint to the variable.
         void set_uniform(const std::string_view name, const UniformValue& value) noexcept;
 
+        //! Set uniform variable.
+        //!
+        //! @param handle the uniform handle obtained with get_uniform
+        //! @param value the uniform value
+        void set_uniform(UniformHandle handle, const UniformValue& value) noexcept;
+
         //! Bind texture to a uniform variable.
         //!
         //! This code will ensure that each texture gets a unique slot and
         //! will remain consisten from call to call.
         //!
+        //! If the texture is resident through TextureResidency its
+        //! bindless handle is set instead and no slot is used.
+        //!
         //! @param name the uniform variable name
         //! @param texture the texture to bind
         void set_uniform(const std::string_view name, Texture& texture) noexcept;
 
+        //! Bind texture with a sampler to a uniform variable.
+        //!
+        //! @param name the uniform variable name
+        //! @param texture the texture to bind
+        //! @param sampler the sampler to use
+        void set_uniform(const std::string_view name, Texture& texture, const Sampler& sampler) noexcept;
+
+        //! Get uniform handle.
+        //!
+        //! The active uniforms are enumerated when the shader is compiled,
+        //! the lookup does not query OpenGL, unless an array element
+        //! not known to the shader is requested.
+        //!
+        //! @param name the uniform variable name
+        //! @return the uniform handle, invalid if the uniform is not active
+        UniformHandle get_uniform(const std::string_view name) noexcept;
+
         //! Get the texture slot for the given variable name.
         uint get_texture_slot(const std::string_view name) noexcept;
 
         //! Get attribute index.
         //!
+        //! The active attributes are enumerated when the shader is
+        //! compiled, the lookup does not query OpenGL.
+        //!
         //! @param name the variable name
         //! @return the index or -1
-        int get_attribute(const std::string_view name) noexcept;
+        int get_attribute(const std::string_view name) const noexcept;
+
+        //! Get the attribute interface identifier.
+        //!
+        //! Shaders with the same active attributes at the same locations
+        //! have the same identifier. Vertex buffers use it to skip
+        //! reconfiguring the vertex array.
+        size_t get_attribute_interface() const noexcept;
 
         //! Bind output to channel.
         //!
@@ -106,14 +190,47 @@ namespace glow
         //! @param channel the chanel index.
         void bind_output(const std::string_view name, uint channel) noexcept;
 
+        //! Bind uniform block to a binding point.
+        //!
+        //! @param name the uniform block name
+        //! @param binding the binding index
+        //!
+        //! @see UniformBuffer::bind
+        void bind_uniform_block(const std::string_view name, uint binding) noexcept;
+
+        //! Bind shader storage block to a binding point.
+        //!
+        //! @param name the shader storage block name
+        //! @param binding the binding index
+        //!
+        //! @see UniformBuffer::bind
+        void bind_storage_block(const std::string_view name, uint binding) noexcept;
+
     private:
         std::string  code;
-        uint program_id = 0;
+        uint program_id  = 0;
+        uint vertex_id   = 0;
+        uint fragment_id = 0;
+
+        std::unordered_map<std::string, int, string_hash, std::equal_to<>> uniform_locations;
+        std::unordered_map<std::string, int, string_hash, std::equal_to<>> attribute_locations;
+        size_t attribute_interface = 0u;
 
         uint last_texture_slot = 0u;
         std::map<std::string, uint, std::less<>> texture_slots;
 
+        bool begin_compile(ProgramCache* cache);
+        bool is_compile_complete() const noexcept;
+        void end_compile(ProgramCache* cache);
+        void release_stages() noexcept;
+        void load_uniforms();
+        void load_attributes();
+
         Shader(const Shader&) = delete;
         const Shader& operator = (const Shader&) = delete;
+
+    friend class UniformBuffer;
+    friend class ShaderCompiler;
+    friend class CommandQueue;
     };
 }
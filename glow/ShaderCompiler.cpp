@@ -0,0 +1,118 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "ShaderCompiler.h"
+#include "util.h"
+
+namespace glow
+{
+    ShaderCompiler::ShaderCompiler() noexcept = default;
+
+    ShaderCompiler::ShaderCompiler(ProgramCache& c) noexcept
+    : cache(&c) {}
+
+    ShaderCompiler::~ShaderCompiler()
+    {
+        while (!pending.empty())
+        {
+            try
+            {
+                complete(pending.size() - 1u);
+            }
+            catch (...)
+            {
+                // nobody is left to report the error to
+            }
+        }
+    }
+
+    bool ShaderCompiler::is_parallel() noexcept
+    {
+        return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+    }
+
+    void ShaderCompiler::set_max_threads(unsigned int count) noexcept
+    {
+        if (GLEW_KHR_parallel_shader_compile)
+        {
+            glMaxShaderCompilerThreadsKHR(count);
+        }
+        else if (GLEW_ARB_parallel_shader_compile)
+        {
+            glMaxShaderCompilerThreadsARB(count);
+        }
+        GLOW_CHECK_GLERROR();
+    }
+
+    void ShaderCompiler::submit(Shader& shader)
+    {
+        if (shader.begin_compile(cache))
+        {
+            // loaded from the program cache
+            return;
+        }
+        pending.push_back(&shader);
+    }
+
+    size_t ShaderCompiler::poll()
+    {
+        auto parallel = is_parallel();
+
+        auto i = size_t{0};
+        while (i < pending.size())
+        {
+            if (!parallel || pending[i]->is_compile_complete())
+            {
+                complete(i);
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        return pending.size();
+    }
+
+    void ShaderCompiler::wait_all()
+    {
+        while (!pending.empty())
+        {
+            complete(0u);
+        }
+    }
+
+    size_t ShaderCompiler::get_pending() const noexcept
+    {
+        return pending.size();
+    }
+
+    void ShaderCompiler::complete(size_t index)
+    {
+        GLOW_ASSERT(index < pending.size());
+
+        // remove the shader first, end_compile may throw
+        auto shader = pending[index];
+        pending.erase(begin(pending) + static_cast<std::ptrdiff_t>(index));
+        shader->end_compile(cache);
+    }
+}
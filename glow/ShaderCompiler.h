@@ -0,0 +1,96 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <vector>
+
+#include "defines.h"
+#include "Shader.h"
+
+namespace glow
+{
+    //! Shader Compiler
+    //!
+    //! The shader compiler compiles many shaders without blocking on each
+    //! shader. All submitted shaders are handed to the driver at once and
+    //! the results are collected with poll or wait_all. With
+    //! KHR_parallel_shader_compile the driver compiles on its own threads
+    //! and poll never blocks, so a loading screen can keep rendering.
+    //! Without the extension poll completes all pending shaders.
+    //!
+    //! Shaders must not be destroyed while they are pending.
+    class GLOW_EXPORT ShaderCompiler
+    {
+    public:
+        //! Create a shader compiler.
+        ShaderCompiler() noexcept;
+
+        //! Create a shader compiler using a program cache.
+        //!
+        //! @param cache the program cache to use
+        ShaderCompiler(ProgramCache& cache) noexcept;
+
+        //! Complete all pending shaders.
+        //!
+        //! @note Compile errors are discarded, use wait_all to see them.
+        ~ShaderCompiler();
+
+        //! Check if the driver compiles shaders in parallel.
+        static bool is_parallel() noexcept;
+
+        //! Set the number of driver compiler threads.
+        //!
+        //! @param count the number of threads, 0xFFFFFFFF for the driver default
+        static void set_max_threads(unsigned int count) noexcept;
+
+        //! Start compiling a shader.
+        //!
+        //! @param shader the shader to compile, the code must be set
+        void submit(Shader& shader);
+
+        //! Complete all shaders that are done compiling.
+        //!
+        //! If a shader failed to compile, it is removed from the pending
+        //! shaders and the error is thrown. Call poll again to continue
+        //! with the remaining shaders.
+        //!
+        //! @return the number of shaders still pending
+        size_t poll();
+
+        //! Complete all pending shaders.
+        //!
+        //! Errors are thrown as with poll.
+        void wait_all();
+
+        //! Get the number of shaders still pending.
+        size_t get_pending() const noexcept;
+
+    private:
+        ProgramCache*        cache = nullptr;
+        std::vector<Shader*> pending;
+
+        void complete(size_t index);
+
+        ShaderCompiler(const ShaderCompiler&) = delete;
+        ShaderCompiler& operator = (const ShaderCompiler&) = delete;
+    };
+}
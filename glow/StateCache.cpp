@@ -0,0 +1,290 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "StateCache.h"
+#include "util.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace glow
+{
+    // state that is not known to the cache
+    constexpr auto UNKNOWN = UINT_MAX;
+
+    thread_local StateCache* current_cache = nullptr;
+
+    int get_target_index(GLenum target) noexcept
+    {
+        switch (target)
+        {
+        case GL_TEXTURE_2D:
+            return 0;
+        case GL_TEXTURE_CUBE_MAP:
+            return 1;
+        case GL_TEXTURE_2D_ARRAY:
+            return 2;
+        case GL_TEXTURE_3D:
+            return 3;
+        case GL_TEXTURE_CUBE_MAP_ARRAY:
+            return 4;
+        default:
+            return -1;
+        }
+    }
+
+    StateCache::StateCache() noexcept
+    {
+        invalidate();
+    }
+
+    StateCache::~StateCache()
+    {
+        if (current_cache == this)
+        {
+            current_cache = nullptr;
+        }
+    }
+
+    StateCache& StateCache::get() noexcept
+    {
+        if (current_cache == nullptr)
+        {
+            static thread_local StateCache default_cache;
+            current_cache = &default_cache;
+        }
+        return *current_cache;
+    }
+
+    void StateCache::make_current() noexcept
+    {
+        current_cache = this;
+    }
+
+    void StateCache::invalidate() noexcept
+    {
+        program          = UNKNOWN;
+        vertex_array     = UNKNOWN;
+        draw_framebuffer = UNKNOWN;
+        read_framebuffer = UNKNOWN;
+        active_unit      = UNKNOWN;
+        textures.clear();
+        samplers.clear();
+    }
+
+    bool StateCache::update(unsigned int& state, unsigned int value) noexcept
+    {
+        if (state == value)
+        {
+            skipped++;
+            return false;
+        }
+
+        state = value;
+        calls++;
+        return true;
+    }
+
+    void StateCache::use_program(unsigned int glid) noexcept
+    {
+        if (update(program, glid))
+        {
+            glUseProgram(glid);
+        }
+    }
+
+    void StateCache::bind_vertex_array(unsigned int glid) noexcept
+    {
+        if (update(vertex_array, glid))
+        {
+            glBindVertexArray(glid);
+        }
+    }
+
+    void StateCache::bind_framebuffer(unsigned int target, unsigned int glid) noexcept
+    {
+        switch (target)
+        {
+        case GL_DRAW_FRAMEBUFFER:
+            if (update(draw_framebuffer, glid))
+            {
+                glBindFramebuffer(GL_DRAW_FRAMEBUFFER, glid);
+            }
+            break;
+        case GL_READ_FRAMEBUFFER:
+            if (update(read_framebuffer, glid))
+            {
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, glid);
+            }
+            break;
+        case GL_FRAMEBUFFER:
+            if (draw_framebuffer == glid && read_framebuffer == glid)
+            {
+                skipped++;
+            }
+            else
+            {
+                draw_framebuffer = glid;
+                read_framebuffer = glid;
+                calls++;
+                glBindFramebuffer(GL_FRAMEBUFFER, glid);
+            }
+            break;
+        default:
+            GLOW_FAIL("Unknown frame buffer target.");
+            break;
+        }
+    }
+
+    void StateCache::active_texture(unsigned int unit) noexcept
+    {
+        if (update(active_unit, unit))
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+        }
+    }
+
+    void StateCache::bind_texture(unsigned int target, unsigned int glid) noexcept
+    {
+        if (active_unit == UNKNOWN)
+        {
+            active_texture(0u);
+        }
+
+        auto index = get_target_index(target);
+        if (index == -1)
+        {
+            calls++;
+            glBindTexture(target, glid);
+            return;
+        }
+
+        if (update(get_unit(active_unit)[index], glid))
+        {
+            glBindTexture(target, glid);
+        }
+    }
+
+    void StateCache::bind_texture(unsigned int unit, unsigned int target, unsigned int glid) noexcept
+    {
+        // only switch the unit if the binding changes
+        auto index = get_target_index(target);
+        if (index != -1 && unit < textures.size() && textures[unit][index] == glid)
+        {
+            skipped++;
+            return;
+        }
+
+        // glBindTextureUnit does not need the active unit, but 0 unbinds all targets
+        if (index != -1 && glid != 0 && has_direct_state_access())
+        {
+            get_unit(unit)[index] = glid;
+            calls++;
+            glBindTextureUnit(unit, glid);
+            return;
+        }
+
+        active_texture(unit);
+        bind_texture(target, glid);
+    }
+
+    void StateCache::bind_sampler(unsigned int unit, unsigned int glid) noexcept
+    {
+        if (unit >= samplers.size())
+        {
+            samplers.resize(unit + 1u, UNKNOWN);
+        }
+
+        if (update(samplers[unit], glid))
+        {
+            glBindSampler(unit, glid);
+        }
+    }
+
+    std::array<unsigned int, StateCache::TEXTURE_TARGETS>& StateCache::get_unit(unsigned int unit) noexcept
+    {
+        if (unit >= textures.size())
+        {
+            auto unknown = std::array<unsigned int, TEXTURE_TARGETS>{};
+            unknown.fill(UNKNOWN);
+            textures.resize(unit + 1u, unknown);
+        }
+        return textures[unit];
+    }
+
+    void StateCache::release_program(unsigned int glid) noexcept
+    {
+        if (program == glid)
+        {
+            program = 0u;
+        }
+    }
+
+    void StateCache::release_vertex_array(unsigned int glid) noexcept
+    {
+        if (vertex_array == glid)
+        {
+            vertex_array = 0u;
+        }
+    }
+
+    void StateCache::release_framebuffer(unsigned int glid) noexcept
+    {
+        if (draw_framebuffer == glid)
+        {
+            draw_framebuffer = 0u;
+        }
+        if (read_framebuffer == glid)
+        {
+            read_framebuffer = 0u;
+        }
+    }
+
+    void StateCache::release_texture(unsigned int glid) noexcept
+    {
+        for (auto& unit : textures)
+        {
+            std::replace(begin(unit), end(unit), glid, 0u);
+        }
+    }
+
+    void StateCache::release_sampler(unsigned int glid) noexcept
+    {
+        std::replace(begin(samplers), end(samplers), glid, 0u);
+    }
+
+    unsigned int StateCache::get_calls() const noexcept
+    {
+        return calls;
+    }
+
+    unsigned int StateCache::get_skipped() const noexcept
+    {
+        return skipped;
+    }
+
+    void StateCache::reset_counters() noexcept
+    {
+        calls   = 0u;
+        skipped = 0u;
+    }
+}
@@ -0,0 +1,136 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "defines.h"
+
+namespace glow
+{
+    //! State Cache
+    //!
+    //! The state cache tracks the bound program, vertex array, frame
+    //! buffers, the active texture unit and the textures and samplers
+    //! bound to each unit, and skips calls that would not change anything. All glow
+    //! wrappers bind through the current state cache.
+    //!
+    //! Each thread has a default state cache. If several contexts are
+    //! used on one thread, create a state cache per context and call
+    //! make_current after making the context current.
+    //!
+    //! When OpenGL state is changed outside of glow, call invalidate,
+    //! so that the next bind is issued unconditionally.
+    class GLOW_EXPORT StateCache
+    {
+    public:
+        //! Create a state cache.
+        StateCache() noexcept;
+
+        //! Release the state cache.
+        ~StateCache();
+
+        //! Get the current state cache of this thread.
+        static StateCache& get() noexcept;
+
+        //! Make this the current state cache of this thread.
+        void make_current() noexcept;
+
+        //! Forget all tracked state.
+        void invalidate() noexcept;
+
+        //! Bind a program with glUseProgram.
+        void use_program(unsigned int glid) noexcept;
+
+        //! Bind a vertex array.
+        void bind_vertex_array(unsigned int glid) noexcept;
+
+        //! Bind a frame buffer.
+        //!
+        //! @param target GL_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER
+        //! @param glid the frame buffer to bind
+        void bind_framebuffer(unsigned int target, unsigned int glid) noexcept;
+
+        //! Select the active texture unit.
+        void active_texture(unsigned int unit) noexcept;
+
+        //! Bind a texture to the active texture unit.
+        //!
+        //! @param target the texture target
+        //! @param glid the texture to bind
+        void bind_texture(unsigned int target, unsigned int glid) noexcept;
+
+        //! Bind a texture to a texture unit.
+        //!
+        //! @param unit the texture unit
+        //! @param target the texture target
+        //! @param glid the texture to bind
+        void bind_texture(unsigned int unit, unsigned int target, unsigned int glid) noexcept;
+
+        //! Bind a sampler to a texture unit.
+        //!
+        //! @param unit the texture unit
+        //! @param glid the sampler to bind, 0 to use the texture's own state
+        void bind_sampler(unsigned int unit, unsigned int glid) noexcept;
+
+        //! Notify the cache about a deleted object.
+        //!
+        //! Deleting an object unbinds it, the cache must follow.
+        //!
+        //! @{
+        void release_program(unsigned int glid) noexcept;
+        void release_vertex_array(unsigned int glid) noexcept;
+        void release_framebuffer(unsigned int glid) noexcept;
+        void release_texture(unsigned int glid) noexcept;
+        void release_sampler(unsigned int glid) noexcept;
+        //! @}
+
+        //! Get the number of calls issued.
+        unsigned int get_calls() const noexcept;
+
+        //! Get the number of redundant calls skipped.
+        unsigned int get_skipped() const noexcept;
+
+        //! Reset the call counters.
+        void reset_counters() noexcept;
+
+    private:
+        static constexpr unsigned int TEXTURE_TARGETS = 5u;
+
+        unsigned int program            = 0u;
+        unsigned int vertex_array       = 0u;
+        unsigned int draw_framebuffer   = 0u;
+        unsigned int read_framebuffer   = 0u;
+        unsigned int active_unit        = 0u;
+        std::vector<std::array<unsigned int, TEXTURE_TARGETS>> textures;
+        std::vector<unsigned int> samplers;
+        unsigned int calls              = 0u;
+        unsigned int skipped            = 0u;
+
+        bool update(unsigned int& state, unsigned int value) noexcept;
+        std::array<unsigned int, TEXTURE_TARGETS>& get_unit(unsigned int unit) noexcept;
+
+        StateCache(const StateCache&) = delete;
+        StateCache& operator = (const StateCache&) = delete;
+    };
+}
@@ -0,0 +1,161 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "StreamBuffer.h"
+#include "util.h"
+
+#include <cstring>
+
+namespace glow
+{
+    constexpr auto STREAM_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    // one second
+    constexpr auto STREAM_TIMEOUT = GLuint64{1000000000};
+
+    StreamBuffer::StreamBuffer(size_t s, unsigned int c)
+    : frame_size(s), frame_count(c), fences(c, nullptr)
+    {
+        GLOW_ASSERT(frame_size > 0u);
+        GLOW_ASSERT(frame_count > 0u);
+
+        auto size = frame_size * frame_count;
+
+        glGenBuffers(1, &glid);
+        glBindBuffer(GL_ARRAY_BUFFER, glid);
+        glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, STREAM_FLAGS);
+        memory = static_cast<std::byte*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, STREAM_FLAGS));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        if (memory == nullptr)
+        {
+            glDeleteBuffers(1, &glid);
+            glid = 0u;
+            throw std::runtime_error("Failed to map stream buffer.");
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    StreamBuffer::~StreamBuffer()
+    {
+        for (auto fence : fences)
+        {
+            if (fence != nullptr)
+            {
+                glDeleteSync(static_cast<GLsync>(fence));
+            }
+        }
+
+        if (glid != 0)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, glid);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            glDeleteBuffers(1, &glid);
+            glid = 0;
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    size_t StreamBuffer::get_frame_size() const noexcept
+    {
+        return frame_size;
+    }
+
+    unsigned int StreamBuffer::get_frame_count() const noexcept
+    {
+        return frame_count;
+    }
+
+    size_t StreamBuffer::get_used() const noexcept
+    {
+        return used;
+    }
+
+    void StreamBuffer::begin_frame() noexcept
+    {
+        if (auto fence = static_cast<GLsync>(fences[frame]); fence != nullptr)
+        {
+            auto result = glClientWaitSync(fence, 0, 0);
+            while (result == GL_TIMEOUT_EXPIRED)
+            {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, STREAM_TIMEOUT);
+            }
+            GLOW_ASSERT(result != GL_WAIT_FAILED);
+
+            glDeleteSync(fence);
+            fences[frame] = nullptr;
+        }
+
+        used = 0u;
+        GLOW_CHECK_GLERROR();
+    }
+
+    void StreamBuffer::end_frame() noexcept
+    {
+        GLOW_ASSERT(fences[frame] == nullptr);
+
+        fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        frame = (frame + 1u) % frame_count;
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    StreamRange StreamBuffer::allocate(size_t size, size_t alignment) noexcept
+    {
+        GLOW_ASSERT(alignment > 0u);
+
+        // align the absolute offset, frame_size need not be a multiple of alignment
+        auto base   = frame * frame_size;
+        auto offset = (base + used + alignment - 1u) / alignment * alignment;
+        if (offset + size > base + frame_size)
+        {
+            return {};
+        }
+
+        used = offset + size - base;
+
+        return {memory + offset, offset, size};
+    }
+
+    StreamRange StreamBuffer::write(const void* data, size_t size, size_t alignment) noexcept
+    {
+        auto range = allocate(size, alignment);
+        if (range.is_valid())
+        {
+            std::memcpy(range.data, data, size);
+        }
+        return range;
+    }
+
+    void StreamBuffer::bind(BlockType type, glm::uint binding, const StreamRange& range) noexcept
+    {
+        GLOW_ASSERT(glid != 0);
+        GLOW_ASSERT(range.is_valid());
+
+        auto target = type == BlockType::UNIFORM ? GL_UNIFORM_BUFFER : GL_SHADER_STORAGE_BUFFER;
+        glBindBufferRange(target, binding, glid, range.offset, range.size);
+        GLOW_CHECK_GLERROR();
+    }
+}
@@ -0,0 +1,132 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <vector>
+
+#include "defines.h"
+#include "UniformBuffer.h"
+
+namespace glow
+{
+    //! Range of a stream buffer.
+    struct StreamRange
+    {
+        //! The mapped memory to write to.
+        void*  data   = nullptr;
+        //! The offset in bytes from the start of the buffer.
+        size_t offset = 0u;
+        //! The size in bytes.
+        size_t size   = 0u;
+
+        //! Check if the allocation succeeded.
+        bool is_valid() const noexcept
+        {
+            return data != nullptr;
+        }
+    };
+
+    //! Stream Buffer
+    //!
+    //! The stream buffer is a persistently mapped ring buffer for data
+    //! that changes every frame, such as particles, UI or debug geometry.
+    //!
+    //! The buffer is split into one region per frame in flight. Memory is
+    //! allocated by bumping a pointer in the current region and written
+    //! directly into the mapping. Each region is guarded by a fence, so
+    //! begin_frame only waits if the GPU is still reading the region
+    //! from frame_count frames ago.
+    //!
+    //! @note Requires OpenGL 4.4 or ARB_buffer_storage.
+    class GLOW_EXPORT StreamBuffer
+    {
+    public:
+        //! Create a stream buffer.
+        //!
+        //! @param frame_size the size in bytes available to each frame
+        //! @param frame_count the number of frames in flight
+        StreamBuffer(size_t frame_size, unsigned int frame_count = 3u);
+
+        //! Release stream buffer.
+        ~StreamBuffer();
+
+        //! Get the size in bytes available to each frame.
+        size_t get_frame_size() const noexcept;
+
+        //! Get the number of frames in flight.
+        unsigned int get_frame_count() const noexcept;
+
+        //! Get the number of bytes allocated in the current frame.
+        size_t get_used() const noexcept;
+
+        //! Start a frame.
+        //!
+        //! Waits until the GPU is done with the current region and
+        //! resets the allocation.
+        void begin_frame() noexcept;
+
+        //! End a frame.
+        //!
+        //! Fences the current region and moves to the next.
+        void end_frame() noexcept;
+
+        //! Allocate memory in the current frame.
+        //!
+        //! @param size the size in bytes
+        //! @param alignment the alignment of the offset in bytes
+        //! @return the allocated range, invalid if the frame is full
+        StreamRange allocate(size_t size, size_t alignment = 16u) noexcept;
+
+        //! Allocate memory in the current frame and copy data into it.
+        //!
+        //! @param data the data to copy
+        //! @param size the size in bytes
+        //! @param alignment the alignment of the offset in bytes
+        //! @return the allocated range, invalid if the frame is full
+        StreamRange write(const void* data, size_t size, size_t alignment = 16u) noexcept;
+
+        //! Bind a range as uniform or shader storage block.
+        //!
+        //! @param type the type of interface block
+        //! @param binding the binding index
+        //! @param range the range to bind
+        //!
+        //! @note The range must be allocated with the alignment given by
+        //! GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT or
+        //! GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT.
+        void bind(BlockType type, glm::uint binding, const StreamRange& range) noexcept;
+
+    private:
+        glm::uint           glid        = 0u;
+        std::byte*          memory      = nullptr;
+        size_t              frame_size  = 0u;
+        unsigned int        frame_count = 0u;
+        unsigned int        frame       = 0u;
+        size_t              used        = 0u;
+        std::vector<void*>  fences;
+
+        StreamBuffer(const StreamBuffer&) = delete;
+        StreamBuffer& operator = (const StreamBuffer&) = delete;
+
+    friend class VertexBuffer;
+    };
+}
@@ -21,27 +21,50 @@
 
 #include "pch.h"
 #include "Texture.h"
+#include "Sampler.h"
+#include "StateCache.h"
+#include "TextureResidency.h"
 #include "util.h"
 
 namespace glow
 {
     Texture::Texture(const std::string_view debug_label) noexcept
+    : label(debug_label) {}
+
+    Texture::~Texture()
     {
-        glGenTextures(1, &glid);
-        GLOW_CHECK_GLERROR();
+        if (residency != nullptr)
+        {
+            residency->release(*this);
+        }
 
-        #ifndef NDEBUG
-        glBindTexture(GL_TEXTURE_2D, glid);
-        glObjectLabel(GL_TEXTURE, glid, static_cast<GLsizei>(debug_label.size()), debug_label.data());
+        glDeleteTextures(1, &glid);
+        StateCache::get().release_texture(glid);
+        glid = 0;
         GLOW_CHECK_GLERROR();
-        glBindTexture(GL_TEXTURE_2D, 0);
-        #endif
     }
 
-    Texture::~Texture()
+    void Texture::create(unsigned int target) noexcept
     {
-        glDeleteTextures(1, &glid);
-        glid = 0;
+        if (glid != 0)
+        {
+            return;
+        }
+
+        // glCreateTextures fixes the target, so the object is made on first use
+        if (has_direct_state_access())
+        {
+            glCreateTextures(target, 1, &glid);
+        }
+        else
+        {
+            glGenTextures(1, &glid);
+            StateCache::get().bind_texture(target, glid);
+        }
+
+        #ifndef NDEBUG
+        glObjectLabel(GL_TEXTURE, glid, static_cast<GLsizei>(label.size()), label.data());
+        #endif
         GLOW_CHECK_GLERROR();
     }
 
@@ -55,6 +78,11 @@ namespace glow
         return size;
     }
 
+    glm::uint Texture::get_layers() const noexcept
+    {
+        return layers;
+    }
+
     ColorMode Texture::get_color_mode() const noexcept
     {
         return color;
@@ -65,24 +93,65 @@ namespace glow
         return data;
     }
 
+    GLenum gltarget(TextureType type) noexcept
+    {
+        switch (type)
+        {
+        case TextureType::TEXTURE2D:
+            return GL_TEXTURE_2D;
+        case TextureType::CUBE_MAP:
+            return GL_TEXTURE_CUBE_MAP;
+        case TextureType::TEXTURE2D_ARRAY:
+            return GL_TEXTURE_2D_ARRAY;
+        case TextureType::TEXTURE3D:
+            return GL_TEXTURE_3D;
+        case TextureType::CUBE_MAP_ARRAY:
+            return GL_TEXTURE_CUBE_MAP_ARRAY;
+        default:
+            GLOW_FAIL("invalid type");
+            return GL_TEXTURE_2D;
+        }
+    }
+
+    GLint get_face_layer(GLenum target) noexcept
+    {
+        if (target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+        {
+            return static_cast<GLint>(target - GL_TEXTURE_CUBE_MAP_POSITIVE_X);
+        }
+        return 0;
+    }
+
     void Texture::bind(glm::uint slot) noexcept
     {
-        GLOW_ASSERT(glid != 0);
+        bind_unit(slot);
+        // a sampler left on the slot would override the texture's state
+        StateCache::get().bind_sampler(slot, 0);
+    }
 
+    void Texture::bind(glm::uint slot, const Sampler& sampler) noexcept
+    {
+        bind_unit(slot);
+        sampler.bind(slot);
+    }
+
+    void Texture::bind_unit(glm::uint slot) noexcept
+    {
+        GLOW_ASSERT(type == TextureType::NO_TEXTURE || glid != 0);
+
+        auto& cache = StateCache::get();
         switch (type)
         {
             case TextureType::NO_TEXTURE:
-                glActiveTexture(GL_TEXTURE0 + slot);
-                glBindTexture(GL_TEXTURE_2D, 0);
-                glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+                cache.bind_texture(slot, GL_TEXTURE_2D, 0);
+                cache.bind_texture(slot, GL_TEXTURE_CUBE_MAP, 0);
                 break;
             case TextureType::TEXTURE2D:
-                glActiveTexture(GL_TEXTURE0 + slot);
-                glBindTexture(GL_TEXTURE_2D, glid);
-                break;
             case TextureType::CUBE_MAP:
-                glActiveTexture(GL_TEXTURE0 + slot);
-                glBindTexture(GL_TEXTURE_CUBE_MAP, glid);
+            case TextureType::TEXTURE2D_ARRAY:
+            case TextureType::TEXTURE3D:
+            case TextureType::CUBE_MAP_ARRAY:
+                cache.bind_texture(slot, gltarget(type), glid);
                 break;
             default:
                 GLOW_FAIL("invalid type");
@@ -95,8 +164,8 @@ namespace glow
 
     void Texture::unbind() noexcept
     {
-        glActiveTexture(GL_TEXTURE0 + last_slot);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        StateCache::get().bind_sampler(last_slot, 0);
+        StateCache::get().bind_texture(last_slot, type != TextureType::NO_TEXTURE ? gltarget(type) : GL_TEXTURE_2D, 0);
     }
 
     GLenum glinternalformat(ColorMode color, DataType data) noexcept
@@ -245,60 +314,245 @@ namespace glow
             return GL_RGBA;
         case ColorMode::BGRA:
             return GL_BGRA;
+        case ColorMode::DEPTH:
+            return GL_DEPTH_COMPONENT;
         default:
             GLOW_FAIL("Unexpected color mode.");
             return GL_RGB;
         }
     }
 
-    GLenum gltype(DataType data) noexcept
+    unsigned int get_gl_format(ColorMode color) noexcept
     {
+        return glformat(color);
+    }
+
+    size_t get_pixel_size(ColorMode color, DataType data) noexcept
+    {
+        auto components = size_t{0};
+        switch (color)
+        {
+        case ColorMode::R:
+        case ColorMode::DEPTH:
+            components = 1u;
+            break;
+        case ColorMode::RG:
+            components = 2u;
+            break;
+        case ColorMode::RGB:
+        case ColorMode::BGR:
+            components = 3u;
+            break;
+        case ColorMode::RGBA:
+        case ColorMode::BGRA:
+            components = 4u;
+            break;
+        default:
+            GLOW_FAIL("Unexpected color mode.");
+            break;
+        }
+
         switch (data)
         {
         case DataType::INT8:
-            return GL_BYTE;
         case DataType::UINT8:
-            return GL_UNSIGNED_BYTE;
+            return components;
         case DataType::INT16:
-            return GL_SHORT;
         case DataType::UINT16:
-            return GL_UNSIGNED_SHORT;
+            return components * 2u;
         case DataType::INT32:
-            return GL_INT;
         case DataType::UINT32:
-            return GL_UNSIGNED_INT;
         case DataType::FLOAT:
-            return GL_FLOAT;
+            return components * 4u;
         case DataType::DOUBLE:
-            return GL_DOUBLE;
+            return components * 8u;
         default:
             GLOW_FAIL("Unexpected type.");
-            return GL_RGB;
+            return components;
         }
     }
 
-    void Texture::upload_2d(glm::uvec2 s, ColorMode c, DataType d, const void* memory, FilterMode filter, WrapMode wrap) noexcept
+    // glTexStorage only accepts sized internal formats
+    GLenum glsizedformat(ColorMode color, DataType data) noexcept
     {
-        GLOW_ASSERT(glid != 0);
-        GLOW_ASSERT(c != ColorMode::UNKNOWN);
-        GLOW_ASSERT(d != DataType::UNKNOWN);
+        if (color == ColorMode::DEPTH)
+        {
+            switch (data)
+            {
+            case DataType::UINT16:
+                return GL_DEPTH_COMPONENT16;
+            case DataType::UINT32:
+                return GL_DEPTH_COMPONENT24;
+            case DataType::FLOAT:
+                return GL_DEPTH_COMPONENT32F;
+            default:
+                GLOW_FAIL("Unexpected depth type.");
+                return GL_DEPTH_COMPONENT24;
+            }
+        }
+
+        if (data == DataType::UINT8)
+        {
+            switch (color)
+            {
+            case ColorMode::R:
+                return GL_R8;
+            case ColorMode::RG:
+                return GL_RG8;
+            case ColorMode::RGB:
+            case ColorMode::BGR:
+                return GL_RGB8;
+            case ColorMode::RGBA:
+            case ColorMode::BGRA:
+                return GL_RGBA8;
+            default:
+                GLOW_FAIL("Unexpected color mode.");
+                return GL_RGBA8;
+            }
+        }
+
+        return glinternalformat(color, data);
+    }
+
+    GLenum glcompressedformat(CompressedFormat format, bool srgb) noexcept
+    {
+        switch (format)
+        {
+        case CompressedFormat::BC1_RGB:
+            return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case CompressedFormat::BC1_RGBA:
+            return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case CompressedFormat::BC2:
+            return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT : GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        case CompressedFormat::BC3:
+            return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case CompressedFormat::BC4:
+            GLOW_ASSERT(!srgb);
+            return GL_COMPRESSED_RED_RGTC1;
+        case CompressedFormat::BC5:
+            GLOW_ASSERT(!srgb);
+            return GL_COMPRESSED_RG_RGTC2;
+        case CompressedFormat::BC6H:
+            GLOW_ASSERT(!srgb);
+            return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+        case CompressedFormat::BC6H_SIGNED:
+            GLOW_ASSERT(!srgb);
+            return GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT;
+        case CompressedFormat::BC7:
+            return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case CompressedFormat::ETC2_RGB:
+            return srgb ? GL_COMPRESSED_SRGB8_ETC2 : GL_COMPRESSED_RGB8_ETC2;
+        case CompressedFormat::ETC2_RGBA:
+            return srgb ? GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC : GL_COMPRESSED_RGBA8_ETC2_EAC;
+        case CompressedFormat::ASTC_4x4:
+            return srgb ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR : GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+        case CompressedFormat::ASTC_5x5:
+            return srgb ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR : GL_COMPRESSED_RGBA_ASTC_5x5_KHR;
+        case CompressedFormat::ASTC_6x6:
+            return srgb ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR : GL_COMPRESSED_RGBA_ASTC_6x6_KHR;
+        case CompressedFormat::ASTC_8x8:
+            return srgb ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR : GL_COMPRESSED_RGBA_ASTC_8x8_KHR;
+        case CompressedFormat::ASTC_10x10:
+            return srgb ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR : GL_COMPRESSED_RGBA_ASTC_10x10_KHR;
+        case CompressedFormat::ASTC_12x12:
+            return srgb ? GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR : GL_COMPRESSED_RGBA_ASTC_12x12_KHR;
+        default:
+            GLOW_FAIL("Unexpected compressed format.");
+            return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        }
+    }
+
+    glm::uvec2 get_block_size(CompressedFormat format) noexcept
+    {
+        switch (format)
+        {
+        case CompressedFormat::ASTC_5x5:
+            return {5u, 5u};
+        case CompressedFormat::ASTC_6x6:
+            return {6u, 6u};
+        case CompressedFormat::ASTC_8x8:
+            return {8u, 8u};
+        case CompressedFormat::ASTC_10x10:
+            return {10u, 10u};
+        case CompressedFormat::ASTC_12x12:
+            return {12u, 12u};
+        case CompressedFormat::NONE:
+            GLOW_FAIL("Texture is not compressed.");
+            return {1u, 1u};
+        default:
+            return {4u, 4u};
+        }
+    }
+
+    size_t get_block_bytes(CompressedFormat format) noexcept
+    {
+        switch (format)
+        {
+        case CompressedFormat::BC1_RGB:
+        case CompressedFormat::BC1_RGBA:
+        case CompressedFormat::BC4:
+        case CompressedFormat::ETC2_RGB:
+            return 8u;
+        case CompressedFormat::NONE:
+            GLOW_FAIL("Texture is not compressed.");
+            return 0u;
+        default:
+            // BC2, BC3, BC5, BC6H, BC7, ETC2 with alpha and all of ASTC
+            return 16u;
+        }
+    }
 
-        type  = TextureType::TEXTURE2D;
-        size  = s;
-        color = c;
-        data  = d;
+    size_t get_compressed_size(CompressedFormat format, glm::uvec2 size) noexcept
+    {
+        auto block  = get_block_size(format);
+        auto blocks = (size + block - glm::uvec2(1u)) / block;
+        return size_t{blocks.x} * size_t{blocks.y} * get_block_bytes(format);
+    }
 
-        glBindTexture(GL_TEXTURE_2D, glid);
+    int get_full_levels(glm::uvec2 size, glm::uint depth = 1u) noexcept
+    {
+        auto levels  = 1;
+        auto largest = std::max({size.x, size.y, depth});
+        while (largest > 1u)
+        {
+            largest >>= 1u;
+            levels++;
+        }
+        return levels;
+    }
+
+    glm::uvec2 get_level_size(glm::uvec2 size, int level) noexcept
+    {
+        return {std::max(size.x >> level, 1u), std::max(size.y >> level, 1u)};
+    }
+
+    void set_parameter(GLuint glid, GLenum target, GLenum name, GLint value) noexcept
+    {
+        if (has_direct_state_access())
+        {
+            glTextureParameteri(glid, name, value);
+        }
+        else
+        {
+            // the texture must be bound to target
+            glTexParameteri(target, name, value);
+        }
+    }
+
+    void set_filter_wrap(GLuint glid, GLenum target, FilterMode filter, WrapMode wrap, int levels) noexcept
+    {
+        // mutable textures are otherwise incomplete with a mipmap sampler
+        set_parameter(glid, target, GL_TEXTURE_MAX_LEVEL, levels - 1);
 
         switch (filter)
         {
         case FilterMode::LINEAR:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            set_parameter(glid, target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            set_parameter(glid, target, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
             break;
         case FilterMode::NEAREST:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            set_parameter(glid, target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            set_parameter(glid, target, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST);
             break;
         default:
             GLOW_FAIL("Unknown filter mode.");
@@ -308,58 +562,114 @@ namespace glow
         switch (wrap)
         {
         case WrapMode::CLAMP:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            set_parameter(glid, target, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+            set_parameter(glid, target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            set_parameter(glid, target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
             break;
         case WrapMode::REPEAT:
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            set_parameter(glid, target, GL_TEXTURE_WRAP_R, GL_REPEAT);
+            set_parameter(glid, target, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            set_parameter(glid, target, GL_TEXTURE_WRAP_T, GL_REPEAT);
             break;
         default:
             GLOW_FAIL("Unknown wrap mode.");
             break;
         }
+    }
+
+    GLenum gltype(DataType data) noexcept
+    {
+        switch (data)
+        {
+        case DataType::INT8:
+            return GL_BYTE;
+        case DataType::UINT8:
+            return GL_UNSIGNED_BYTE;
+        case DataType::INT16:
+            return GL_SHORT;
+        case DataType::UINT16:
+            return GL_UNSIGNED_SHORT;
+        case DataType::INT32:
+            return GL_INT;
+        case DataType::UINT32:
+            return GL_UNSIGNED_INT;
+        case DataType::FLOAT:
+            return GL_FLOAT;
+        case DataType::DOUBLE:
+            return GL_DOUBLE;
+        default:
+            GLOW_FAIL("Unexpected type.");
+            return GL_RGB;
+        }
+    }
+
+    // largest unpack alignment that the rows and the start of bits satisfy
+    GLint get_unpack_alignment(size_t row_size, const void* bits) noexcept
+    {
+        auto address = reinterpret_cast<uintptr_t>(bits);
+        for (auto alignment : {8u, 4u, 2u})
+        {
+            if (row_size % alignment == 0u && address % alignment == 0u)
+            {
+                return static_cast<GLint>(alignment);
+            }
+        }
+        return 1;
+    }
+
+    unsigned int get_gl_type(DataType data) noexcept
+    {
+        return gltype(data);
+    }
+
+    void Texture::upload_2d(glm::uvec2 s, ColorMode c, DataType d, const void* memory, FilterMode filter, WrapMode wrap) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::upload_2d");
+        GLOW_ASSERT(c != ColorMode::UNKNOWN);
+        GLOW_ASSERT(d != DataType::UNKNOWN);
+
+        GLOW_ASSERT(!immutable);
+
+        type       = TextureType::TEXTURE2D;
+        size       = s;
+        color      = c;
+        data       = d;
+        levels     = 1;
+        compressed = CompressedFormat::NONE;
+
+        create(GL_TEXTURE_2D);
+        StateCache::get().bind_texture(GL_TEXTURE_2D, glid);
+
+        set_filter_wrap(glid, GL_TEXTURE_2D, filter, wrap, 1);
 
         GLenum gl_internalformat = glinternalformat(color, data);
         GLenum gl_format         = glformat(color);
         GLenum gl_type           = gltype(data);
         glTexImage2D(GL_TEXTURE_2D, 0, gl_internalformat, size.x, size.y, 0, gl_format, gl_type, memory);
 
-        glBindTexture(GL_TEXTURE_2D, 0);
         GLOW_CHECK_GLERROR();
     }
 
     void Texture::upload_cube(unsigned int resolution, ColorMode c, DataType d, const void* xpos, const void* xneg, const void* ypos, const void* yneg, const void* zpos, const void* zneg, FilterMode filter) noexcept
     {
-        GLOW_ASSERT(glid != 0);
+        GLOW_DEBUG_GROUP("Texture::upload_cube");
+        GLOW_ASSERT(!immutable);
 
-        type  = TextureType::CUBE_MAP;
-        size  = glm::uvec2(resolution);
-        color = c;
-        data  = d;
+        type       = TextureType::CUBE_MAP;
+        size       = glm::uvec2(resolution);
+        color      = c;
+        data       = d;
+        levels     = 1;
+        compressed = CompressedFormat::NONE;
 
         GLenum gl_internalformat = glinternalformat(color, data);
         GLenum gl_format         = glformat(color);
         GLenum gl_type           = gltype(data);
 
-        glBindTexture(GL_TEXTURE_CUBE_MAP, glid);
+        create(GL_TEXTURE_CUBE_MAP);
+        StateCache::get().bind_texture(GL_TEXTURE_CUBE_MAP, glid);
 
-        if (filter == FilterMode::NEAREST)
-        {
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        }
-        else
-        {
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        }
-
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        set_filter_wrap(glid, GL_TEXTURE_CUBE_MAP, filter, WrapMode::CLAMP, 1);
 
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, gl_internalformat, resolution, resolution, 0, gl_format, gl_type, xpos);
         glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_X, 0, gl_internalformat, resolution, resolution, 0, gl_format, gl_type, xneg);
@@ -368,55 +678,587 @@ namespace glow
         glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Z, 0, gl_internalformat, resolution, resolution, 0, gl_format, gl_type, zpos);
         glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, 0, gl_internalformat, resolution, resolution, 0, gl_format, gl_type, zneg);
 
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 
         GLOW_CHECK_GLERROR();
     }
 
-    void Texture::generate_mipmaps() noexcept
+    void Texture::allocate_2d(glm::uvec2 s, ColorMode c, DataType d, int l, FilterMode filter, WrapMode wrap) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::allocate_2d");
+        GLOW_ASSERT(!immutable);
+        GLOW_ASSERT(c != ColorMode::UNKNOWN);
+        GLOW_ASSERT(d != DataType::UNKNOWN);
+
+        type       = TextureType::TEXTURE2D;
+        size       = s;
+        color      = c;
+        data       = d;
+        compressed = CompressedFormat::NONE;
+        levels     = l > 0 ? std::min(l, get_full_levels(s)) : get_full_levels(s);
+        immutable  = true;
+
+        create(GL_TEXTURE_2D);
+        if (has_direct_state_access())
+        {
+            glTextureStorage2D(glid, levels, glsizedformat(color, data), size.x, size.y);
+        }
+        else
+        {
+            StateCache::get().bind_texture(GL_TEXTURE_2D, glid);
+            glTexStorage2D(GL_TEXTURE_2D, levels, glsizedformat(color, data), size.x, size.y);
+        }
+        set_filter_wrap(glid, GL_TEXTURE_2D, filter, wrap, levels);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Texture::allocate_cube(glm::uint resolution, ColorMode c, DataType d, int l, FilterMode filter) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::allocate_cube");
+        GLOW_ASSERT(!immutable);
+        GLOW_ASSERT(c != ColorMode::UNKNOWN);
+        GLOW_ASSERT(d != DataType::UNKNOWN);
+
+        type       = TextureType::CUBE_MAP;
+        size       = glm::uvec2(resolution);
+        color      = c;
+        data       = d;
+        compressed = CompressedFormat::NONE;
+        levels     = l > 0 ? std::min(l, get_full_levels(size)) : get_full_levels(size);
+        immutable  = true;
+
+        create(GL_TEXTURE_CUBE_MAP);
+        if (has_direct_state_access())
+        {
+            glTextureStorage2D(glid, levels, glsizedformat(color, data), size.x, size.y);
+        }
+        else
+        {
+            StateCache::get().bind_texture(GL_TEXTURE_CUBE_MAP, glid);
+            glTexStorage2D(GL_TEXTURE_CUBE_MAP, levels, glsizedformat(color, data), size.x, size.y);
+        }
+        set_filter_wrap(glid, GL_TEXTURE_CUBE_MAP, filter, WrapMode::CLAMP, levels);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Texture::allocate_2d_array(glm::uvec2 s, glm::uint n, ColorMode c, DataType d, int l, FilterMode filter, WrapMode wrap) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::allocate_2d_array");
+        GLOW_ASSERT(!immutable);
+        GLOW_ASSERT(c != ColorMode::UNKNOWN);
+        GLOW_ASSERT(d != DataType::UNKNOWN);
+        GLOW_ASSERT(n > 0u);
+
+        type       = TextureType::TEXTURE2D_ARRAY;
+        size       = s;
+        layers     = n;
+        color      = c;
+        data       = d;
+        compressed = CompressedFormat::NONE;
+        levels     = l > 0 ? std::min(l, get_full_levels(s)) : get_full_levels(s);
+        immutable  = true;
+
+        create(GL_TEXTURE_2D_ARRAY);
+        if (has_direct_state_access())
+        {
+            glTextureStorage3D(glid, levels, glsizedformat(color, data), size.x, size.y, layers);
+        }
+        else
+        {
+            StateCache::get().bind_texture(GL_TEXTURE_2D_ARRAY, glid);
+            glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, glsizedformat(color, data), size.x, size.y, layers);
+        }
+        set_filter_wrap(glid, GL_TEXTURE_2D_ARRAY, filter, wrap, levels);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Texture::allocate_3d(glm::uvec3 s, ColorMode c, DataType d, int l, FilterMode filter, WrapMode wrap) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::allocate_3d");
+        GLOW_ASSERT(!immutable);
+        GLOW_ASSERT(c != ColorMode::UNKNOWN);
+        GLOW_ASSERT(d != DataType::UNKNOWN);
+        GLOW_ASSERT(s.z > 0u);
+
+        type       = TextureType::TEXTURE3D;
+        size       = glm::uvec2(s.x, s.y);
+        layers     = s.z;
+        color      = c;
+        data       = d;
+        compressed = CompressedFormat::NONE;
+        levels     = l > 0 ? std::min(l, get_full_levels(size, layers)) : get_full_levels(size, layers);
+        immutable  = true;
+
+        create(GL_TEXTURE_3D);
+        if (has_direct_state_access())
+        {
+            glTextureStorage3D(glid, levels, glsizedformat(color, data), size.x, size.y, layers);
+        }
+        else
+        {
+            StateCache::get().bind_texture(GL_TEXTURE_3D, glid);
+            glTexStorage3D(GL_TEXTURE_3D, levels, glsizedformat(color, data), size.x, size.y, layers);
+        }
+        set_filter_wrap(glid, GL_TEXTURE_3D, filter, wrap, levels);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Texture::allocate_cube_array(glm::uint resolution, glm::uint cubes, ColorMode c, DataType d, int l, FilterMode filter) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::allocate_cube_array");
+        GLOW_ASSERT(!immutable);
+        GLOW_ASSERT(c != ColorMode::UNKNOWN);
+        GLOW_ASSERT(d != DataType::UNKNOWN);
+        GLOW_ASSERT(cubes > 0u);
+
+        type       = TextureType::CUBE_MAP_ARRAY;
+        size       = glm::uvec2(resolution);
+        layers     = cubes;
+        color      = c;
+        data       = d;
+        compressed = CompressedFormat::NONE;
+        levels     = l > 0 ? std::min(l, get_full_levels(size)) : get_full_levels(size);
+        immutable  = true;
+
+        create(GL_TEXTURE_CUBE_MAP_ARRAY);
+        if (has_direct_state_access())
+        {
+            glTextureStorage3D(glid, levels, glsizedformat(color, data), size.x, size.y, layers * 6u);
+        }
+        else
+        {
+            StateCache::get().bind_texture(GL_TEXTURE_CUBE_MAP_ARRAY, glid);
+            glTexStorage3D(GL_TEXTURE_CUBE_MAP_ARRAY, levels, glsizedformat(color, data), size.x, size.y, layers * 6u);
+        }
+        set_filter_wrap(glid, GL_TEXTURE_CUBE_MAP_ARRAY, filter, WrapMode::CLAMP, levels);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Texture::upload_layer(glm::uint layer, int level, const void* bits) noexcept
     {
+        GLOW_DEBUG_GROUP("Texture::upload_layer");
+        GLOW_ASSERT(glid != 0);
+        GLOW_ASSERT(immutable);
+        GLOW_ASSERT(compressed == CompressedFormat::NONE);
+        GLOW_ASSERT(level >= 0 && level < levels);
+
+        auto level_size = get_level_size(size, level);
         switch (type)
         {
-            case TextureType::TEXTURE2D:
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, glid);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-                glGenerateMipmap(GL_TEXTURE_2D);
-                glBindTexture(GL_TEXTURE_2D, 0);
-                break;
-            case TextureType::CUBE_MAP:
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_CUBE_MAP, glid);
-                glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-                glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
-                glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-                break;
-            default:
-                assert(false && "no texture to mipmap");
-                break;
+        case TextureType::TEXTURE2D_ARRAY:
+            GLOW_ASSERT(layer < layers);
+            break;
+        case TextureType::TEXTURE3D:
+            GLOW_ASSERT(layer < std::max(layers >> level, 1u));
+            break;
+        case TextureType::CUBE_MAP_ARRAY:
+            GLOW_ASSERT(layer < layers * 6u);
+            break;
+        default:
+            GLOW_FAIL("Texture has no layers.");
+            break;
+        }
+
+        auto target   = gltarget(type);
+        auto row_size = level_size.x * get_pixel_size(color, data);
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, get_unpack_alignment(row_size, bits));
+        if (has_direct_state_access())
+        {
+            glTextureSubImage3D(glid, level, 0, 0, layer, level_size.x, level_size.y, 1, glformat(color), gltype(data), bits);
+        }
+        else
+        {
+            StateCache::get().bind_texture(target, glid);
+            glTexSubImage3D(target, level, 0, 0, layer, level_size.x, level_size.y, 1, glformat(color), gltype(data), bits);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Texture::upload_level(int level, const void* bits) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::upload_level");
+        GLOW_ASSERT(immutable);
+        GLOW_ASSERT(type == TextureType::TEXTURE2D);
+        GLOW_ASSERT(level >= 0 && level < levels);
+
+        write_region(GL_TEXTURE_2D, level, glm::uvec2(0u), get_level_size(size, level), bits);
+    }
+
+    void Texture::upload_level(CubeFace face, int level, const void* bits) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::upload_level");
+        GLOW_ASSERT(immutable);
+        GLOW_ASSERT(type == TextureType::CUBE_MAP);
+        GLOW_ASSERT(level >= 0 && level < levels);
+
+        auto target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(face);
+        write_region(target, level, glm::uvec2(0u), get_level_size(size, level), bits);
+    }
+
+    void Texture::upload_compressed_2d(glm::uvec2 s, CompressedFormat f, bool sr, const void* bits, FilterMode filter, WrapMode wrap) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::upload_compressed_2d");
+        GLOW_ASSERT(!immutable);
+        GLOW_ASSERT(f != CompressedFormat::NONE);
+
+        type       = TextureType::TEXTURE2D;
+        size       = s;
+        color      = ColorMode::UNKNOWN;
+        data       = DataType::UNKNOWN;
+        compressed = f;
+        srgb       = sr;
+        levels     = 1;
+
+        auto image_size = static_cast<GLsizei>(get_compressed_size(compressed, size));
+
+        create(GL_TEXTURE_2D);
+        StateCache::get().bind_texture(GL_TEXTURE_2D, glid);
+        set_filter_wrap(glid, GL_TEXTURE_2D, filter, wrap, 1);
+        glCompressedTexImage2D(GL_TEXTURE_2D, 0, glcompressedformat(compressed, srgb), size.x, size.y, 0, image_size, bits);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Texture::allocate_compressed_2d(glm::uvec2 s, CompressedFormat f, bool sr, int l, FilterMode filter, WrapMode wrap) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::allocate_compressed_2d");
+        GLOW_ASSERT(!immutable);
+        GLOW_ASSERT(f != CompressedFormat::NONE);
+
+        type       = TextureType::TEXTURE2D;
+        size       = s;
+        color      = ColorMode::UNKNOWN;
+        data       = DataType::UNKNOWN;
+        compressed = f;
+        srgb       = sr;
+        levels     = l > 0 ? std::min(l, get_full_levels(s)) : get_full_levels(s);
+        immutable  = true;
+
+        create(GL_TEXTURE_2D);
+        if (has_direct_state_access())
+        {
+            glTextureStorage2D(glid, levels, glcompressedformat(compressed, srgb), size.x, size.y);
+        }
+        else
+        {
+            StateCache::get().bind_texture(GL_TEXTURE_2D, glid);
+            glTexStorage2D(GL_TEXTURE_2D, levels, glcompressedformat(compressed, srgb), size.x, size.y);
+        }
+        set_filter_wrap(glid, GL_TEXTURE_2D, filter, wrap, levels);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Texture::allocate_compressed_cube(glm::uint resolution, CompressedFormat f, bool sr, int l, FilterMode filter) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::allocate_compressed_cube");
+        GLOW_ASSERT(!immutable);
+        GLOW_ASSERT(f != CompressedFormat::NONE);
+
+        type       = TextureType::CUBE_MAP;
+        size       = glm::uvec2(resolution);
+        color      = ColorMode::UNKNOWN;
+        data       = DataType::UNKNOWN;
+        compressed = f;
+        srgb       = sr;
+        levels     = l > 0 ? std::min(l, get_full_levels(size)) : get_full_levels(size);
+        immutable  = true;
+
+        create(GL_TEXTURE_CUBE_MAP);
+        if (has_direct_state_access())
+        {
+            glTextureStorage2D(glid, levels, glcompressedformat(compressed, srgb), size.x, size.y);
+        }
+        else
+        {
+            StateCache::get().bind_texture(GL_TEXTURE_CUBE_MAP, glid);
+            glTexStorage2D(GL_TEXTURE_CUBE_MAP, levels, glcompressedformat(compressed, srgb), size.x, size.y);
+        }
+        set_filter_wrap(glid, GL_TEXTURE_CUBE_MAP, filter, WrapMode::CLAMP, levels);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Texture::upload_compressed_level(int level, const void* bits) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::upload_compressed_level");
+        GLOW_ASSERT(type == TextureType::TEXTURE2D);
+        write_compressed_level(GL_TEXTURE_2D, level, bits);
+    }
+
+    void Texture::upload_compressed_level(CubeFace face, int level, const void* bits) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::upload_compressed_level");
+        GLOW_ASSERT(type == TextureType::CUBE_MAP);
+        write_compressed_level(GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(face), level, bits);
+    }
+
+    CompressedFormat Texture::get_compressed_format() const noexcept
+    {
+        return compressed;
+    }
+
+    void Texture::write_compressed_level(unsigned int target, int level, const void* bits) noexcept
+    {
+        GLOW_ASSERT(glid != 0);
+        GLOW_ASSERT(immutable);
+        GLOW_ASSERT(compressed != CompressedFormat::NONE);
+        GLOW_ASSERT(level >= 0 && level < levels);
+
+        auto bind_target = gltarget(type);
+        auto level_size  = get_level_size(size, level);
+        auto image_size  = static_cast<GLsizei>(get_compressed_size(compressed, level_size));
+        auto format      = glcompressedformat(compressed, srgb);
+
+        if (!has_direct_state_access())
+        {
+            StateCache::get().bind_texture(bind_target, glid);
+            glCompressedTexSubImage2D(target, level, 0, 0, level_size.x, level_size.y, format, image_size, bits);
+        }
+        else if (bind_target == GL_TEXTURE_CUBE_MAP)
+        {
+            glCompressedTextureSubImage3D(glid, level, 0, 0, get_face_layer(target), level_size.x, level_size.y, 1, format, image_size, bits);
+        }
+        else
+        {
+            glCompressedTextureSubImage2D(glid, level, 0, 0, level_size.x, level_size.y, format, image_size, bits);
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Texture::update_region(glm::uvec2 offset, glm::uvec2 region, int level, const void* bits, glm::uint row_length) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::update_region");
+        GLOW_ASSERT(type == TextureType::TEXTURE2D);
+        write_region(GL_TEXTURE_2D, level, offset, region, bits, row_length);
+    }
+
+    void Texture::update_region(CubeFace face, glm::uvec2 offset, glm::uvec2 region, int level, const void* bits, glm::uint row_length) noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::update_region");
+        GLOW_ASSERT(type == TextureType::CUBE_MAP);
+
+        auto target = GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(face);
+        write_region(target, level, offset, region, bits, row_length);
+    }
+
+    void Texture::write_region(unsigned int target, int level, glm::uvec2 offset, glm::uvec2 region, const void* bits, glm::uint row_length) noexcept
+    {
+        GLOW_ASSERT(glid != 0);
+        GLOW_ASSERT(compressed == CompressedFormat::NONE);
+        GLOW_ASSERT(level >= 0 && level < levels);
+        GLOW_ASSERT(row_length == 0u || row_length >= region.x);
+
+        GLOW_ASSERT(glm::all(glm::lessThanEqual(offset + region, get_level_size(size, level))));
+
+        auto bind_target = gltarget(type);
+        auto row_size    = (row_length != 0u ? row_length : region.x) * get_pixel_size(color, data);
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, get_unpack_alignment(row_size, bits));
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(row_length));
+        if (!has_direct_state_access())
+        {
+            StateCache::get().bind_texture(bind_target, glid);
+            glTexSubImage2D(target, level, offset.x, offset.y, region.x, region.y, glformat(color), gltype(data), bits);
+        }
+        else if (bind_target == GL_TEXTURE_CUBE_MAP)
+        {
+            // the faces of a cube map are layers
+            glTextureSubImage3D(glid, level, offset.x, offset.y, get_face_layer(target), region.x, region.y, 1, glformat(color), gltype(data), bits);
+        }
+        else
+        {
+            glTextureSubImage2D(glid, level, offset.x, offset.y, region.x, region.y, glformat(color), gltype(data), bits);
+        }
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void Texture::set_base_level(int level) noexcept
+    {
+        GLOW_ASSERT(glid != 0);
+        GLOW_ASSERT(level >= 0 && level < levels);
+
+        auto target = gltarget(type);
+
+        if (!has_direct_state_access())
+        {
+            StateCache::get().bind_texture(target, glid);
+        }
+        set_parameter(glid, target, GL_TEXTURE_BASE_LEVEL, level);
+        base_level = level;
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    int Texture::get_base_level() const noexcept
+    {
+        return base_level;
+    }
+
+    void Texture::generate_mipmaps() noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::generate_mipmaps");
+        GLOW_ASSERT(type != TextureType::NO_TEXTURE);
+        GLOW_ASSERT(compressed == CompressedFormat::NONE);
+
+        if (!immutable)
+        {
+            levels = get_full_levels(size, type == TextureType::TEXTURE3D ? layers : 1u);
+        }
+
+        auto target = gltarget(type);
+        auto dsa    = has_direct_state_access();
+
+        // keep the nearest or linear choice, but sample the new levels
+        auto min_filter = GLint{0};
+        if (dsa)
+        {
+            glGetTextureParameteriv(glid, GL_TEXTURE_MIN_FILTER, &min_filter);
+        }
+        else
+        {
+            StateCache::get().bind_texture(target, glid);
+            glGetTexParameteriv(target, GL_TEXTURE_MIN_FILTER, &min_filter);
+        }
+
+        if (min_filter == GL_LINEAR)
+        {
+            set_parameter(glid, target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        }
+        else if (min_filter == GL_NEAREST)
+        {
+            set_parameter(glid, target, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        }
+
+        // mutable textures only generate the levels up to GL_TEXTURE_MAX_LEVEL
+        if (!immutable)
+        {
+            set_parameter(glid, target, GL_TEXTURE_MAX_LEVEL, levels - 1);
         }
 
-        // NOTE: make this configurable
-        auto aniso = 0.0f;
-        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &aniso);
-        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, aniso);
+        if (dsa)
+        {
+            glGenerateTextureMipmap(glid);
+        }
+        else
+        {
+            glGenerateMipmap(target);
+        }
+
+        GLOW_CHECK_GLERROR();
     }
 
     int Texture::get_mipmap_levels() const noexcept
     {
-        int result = 0;
+        return levels;
+    }
+
+    std::vector<std::byte> Texture::read_pixels(int level) const noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::read_pixels");
+        GLOW_ASSERT(type == TextureType::TEXTURE2D);
+
+        auto level_size = get_level_size(size, level);
+        auto result     = std::vector<std::byte>(size_t{level_size.x} * level_size.y * get_pixel_size(color, data));
+        read_level(GL_TEXTURE_2D, level, result.data());
+        return result;
+    }
+
+    std::vector<std::byte> Texture::read_pixels(CubeFace face, int level) const noexcept
+    {
+        GLOW_DEBUG_GROUP("Texture::read_pixels");
+        GLOW_ASSERT(type == TextureType::CUBE_MAP);
+
+        auto level_size = get_level_size(size, level);
+        auto result     = std::vector<std::byte>(size_t{level_size.x} * level_size.y * get_pixel_size(color, data));
+        read_level(GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(face), level, result.data());
+        return result;
+    }
+
+    void Texture::read_level(unsigned int target, int level, void* bits) const noexcept
+    {
+        GLOW_ASSERT(glid != 0);
+        GLOW_ASSERT(compressed == CompressedFormat::NONE);
+        GLOW_ASSERT(level >= 0 && level < levels);
+
+        auto bind_target = gltarget(type);
+        auto level_size  = get_level_size(size, level);
+        auto image_size  = static_cast<GLsizei>(size_t{level_size.x} * level_size.y * get_pixel_size(color, data));
+
+        // rows are tightly packed, as they are counted by the callers
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        // glGetTextureSubImage is not part of ARB_direct_state_access
+        if (has_direct_state_access() && (GLEW_VERSION_4_5 || GLEW_ARB_get_texture_sub_image))
+        {
+            glGetTextureSubImage(glid, level, 0, 0, get_face_layer(target), level_size.x, level_size.y, 1, glformat(color), gltype(data), image_size, bits);
+        }
+        else
+        {
+            StateCache::get().bind_texture(bind_target, glid);
+            glGetTexImage(target, level, glformat(color), gltype(data), bits);
+        }
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    size_t Texture::get_memory_size() const noexcept
+    {
+        auto faces = size_t{1};
         switch (type)
         {
-            case TextureType::TEXTURE2D:
-                glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &result);
-                break;
-            case TextureType::CUBE_MAP:
-                glGetTexParameteriv(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, &result);
-                break;
-            default:
-                GLOW_FAIL("no texture to mipmap");
-                break;
+        case TextureType::CUBE_MAP:
+            faces = 6u;
+            break;
+        case TextureType::TEXTURE2D_ARRAY:
+            faces = layers;
+            break;
+        case TextureType::CUBE_MAP_ARRAY:
+            faces = layers * 6u;
+            break;
+        default:
+            break;
         }
-        return result;
+
+        auto total = size_t{0};
+        for (auto level = 0; level < levels; level++)
+        {
+            auto level_size = get_level_size(size, level);
+            auto image_size = compressed != CompressedFormat::NONE
+                            ? get_compressed_size(compressed, level_size)
+                            : size_t{level_size.x} * level_size.y * get_pixel_size(color, data);
+            // 3D textures shrink in depth as well
+            auto depth = type == TextureType::TEXTURE3D ? std::max(layers >> level, 1u) : 1u;
+            total += image_size * faces * depth;
+        }
+        return total;
+    }
+
+    std::uint64_t Texture::get_handle() noexcept
+    {
+        GLOW_ASSERT(glid != 0);
+
+        if (handle == 0u && GLEW_ARB_bindless_texture)
+        {
+            handle = glGetTextureHandleARB(glid);
+            GLOW_CHECK_GLERROR();
+        }
+        return handle;
+    }
+
+    bool Texture::is_resident() const noexcept
+    {
+        return residency != nullptr;
     }
 }
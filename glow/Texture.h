@@ -21,13 +21,19 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <string_view>
+#include <vector>
 #include <glm/glm.hpp>
 
 #include "defines.h"
 
 namespace glow
 {
+    class TextureResidency;
+    class Sampler;
+
     //! Color Mode
     enum class ColorMode
     {
@@ -60,7 +66,10 @@ namespace glow
     {
         NO_TEXTURE,
         TEXTURE2D,
-        CUBE_MAP
+        CUBE_MAP,
+        TEXTURE2D_ARRAY,
+        TEXTURE3D,
+        CUBE_MAP_ARRAY
     };
 
     //! Cube map face.
@@ -88,9 +97,68 @@ namespace glow
         REPEAT
     };
 
+    //! Compressed Format
+    //!
+    //! The block compressed formats, for BC1 to BC3, BC7, ETC2 and ASTC
+    //! a sRGB variant can be selected when allocating the texture.
+    enum class CompressedFormat
+    {
+        NONE,
+        BC1_RGB,
+        BC1_RGBA,
+        BC2,
+        BC3,
+        BC4,
+        BC5,
+        BC6H,
+        BC6H_SIGNED,
+        BC7,
+        ETC2_RGB,
+        ETC2_RGBA,
+        ASTC_4x4,
+        ASTC_5x5,
+        ASTC_6x6,
+        ASTC_8x8,
+        ASTC_10x10,
+        ASTC_12x12
+    };
+
+    //! Get the size of one pixel in bytes.
+    //!
+    //! @param color the color mode
+    //! @param data the data type
+    GLOW_EXPORT size_t get_pixel_size(ColorMode color, DataType data) noexcept;
+
+    //! Get the OpenGL pixel format of a color mode.
+    //!
+    //! @param color the color mode
+    GLOW_EXPORT unsigned int get_gl_format(ColorMode color) noexcept;
+
+    //! Get the OpenGL pixel type of a data type.
+    //!
+    //! @param data the data type
+    GLOW_EXPORT unsigned int get_gl_type(DataType data) noexcept;
+
+    //! Get the size of a compressed block in pixels.
+    //!
+    //! @param format the compressed format
+    GLOW_EXPORT glm::uvec2 get_block_size(CompressedFormat format) noexcept;
+
+    //! Get the size of a compressed block in bytes.
+    //!
+    //! @param format the compressed format
+    GLOW_EXPORT size_t get_block_bytes(CompressedFormat format) noexcept;
+
+    //! Get the size of a compressed image in bytes.
+    //!
+    //! @param format the compressed format
+    //! @param size the size of the image in pixels
+    GLOW_EXPORT size_t get_compressed_size(CompressedFormat format, glm::uvec2 size) noexcept;
+
     //! Texture
     //!
-    //! The textrue class can represent GL_TEXTURE_2D and GL_TEXTURE_CUBE_MAP.
+    //! The textrue class can represent GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP,
+    //! GL_TEXTURE_2D_ARRAY, GL_TEXTURE_3D and GL_TEXTURE_CUBE_MAP_ARRAY.
     class GLOW_EXPORT Texture
     {
     public:
@@ -112,6 +180,12 @@ namespace glow
         //! @return the size of texture in pixels
         glm::uvec2 get_size() const noexcept;
 
+        //! Get the number of layers.
+        //!
+        //! @return the number of layers of an array, the depth of a 3D
+        //! texture, the number of cubes of a cube map array or 1
+        glm::uint get_layers() const noexcept;
+
         //! Get texture color mode.
         //!
         //! @return the color mode of texture
@@ -124,11 +198,22 @@ namespace glow
 
         //! Bind texture to a given slot.
         //!
+        //! A sampler bound to the slot is unbound, so that the texture's
+        //! own filter and wrap state is used.
+        //!
         //! @param slot the texture slot to bind the texture to.
         //!
         //! @see Shader::set_uniform
         void bind(glm::uint slot) noexcept;
 
+        //! Bind texture with a sampler to a given slot.
+        //!
+        //! The sampler overrides the texture's own filter and wrap state.
+        //!
+        //! @param slot the texture slot to bind the texture to.
+        //! @param sampler the sampler to use
+        void bind(glm::uint slot, const Sampler& sampler) noexcept;
+
         //! Unbind texture.
         void unbind() noexcept;
 
@@ -155,24 +240,235 @@ namespace glow
         //! @param filter the filter mode
         void upload_cube(glm::uint resolution, ColorMode mode, DataType data, const void* xpos = nullptr, const void* xneg = nullptr, const void* ypos = nullptr, const void* yneg = nullptr, const void* zpos = nullptr, const void* zneg = nullptr, FilterMode filter = FilterMode::LINEAR) noexcept;
 
+        //! Allocate immutable 2D texture storage.
+        //!
+        //! The storage for all mipmap levels is allocated at once and can
+        //! not be changed afterwards. The levels are uploaded with
+        //! upload_level or generated with generate_mipmaps.
+        //!
+        //! @param size the size in pixels
+        //! @param color the color mode
+        //! @param data the data type
+        //! @param levels the number of mipmap levels, 0 for the full chain
+        //! @param filter the filter mode
+        //! @param wrap the wrapping mode
+        void allocate_2d(glm::uvec2 size, ColorMode color, DataType data, int levels = 0, FilterMode filter = FilterMode::LINEAR, WrapMode wrap = WrapMode::REPEAT) noexcept;
+
+        //! Allocate immutable cube map storage.
+        //!
+        //! @param resolution the size of each face in pixels
+        //! @param color the color mode
+        //! @param data the data type
+        //! @param levels the number of mipmap levels, 0 for the full chain
+        //! @param filter the filter mode
+        void allocate_cube(glm::uint resolution, ColorMode color, DataType data, int levels = 0, FilterMode filter = FilterMode::LINEAR) noexcept;
+
+        //! Allocate immutable 2D array texture storage.
+        //!
+        //! @param size the size of each layer in pixels
+        //! @param layers the number of layers
+        //! @param color the color mode
+        //! @param data the data type
+        //! @param levels the number of mipmap levels, 0 for the full chain
+        //! @param filter the filter mode
+        //! @param wrap the wrapping mode
+        void allocate_2d_array(glm::uvec2 size, glm::uint layers, ColorMode color, DataType data, int levels = 0, FilterMode filter = FilterMode::LINEAR, WrapMode wrap = WrapMode::REPEAT) noexcept;
+
+        //! Allocate immutable 3D texture storage.
+        //!
+        //! @param size the size in pixels
+        //! @param color the color mode
+        //! @param data the data type
+        //! @param levels the number of mipmap levels, 0 for the full chain
+        //! @param filter the filter mode
+        //! @param wrap the wrapping mode
+        void allocate_3d(glm::uvec3 size, ColorMode color, DataType data, int levels = 0, FilterMode filter = FilterMode::LINEAR, WrapMode wrap = WrapMode::REPEAT) noexcept;
+
+        //! Allocate immutable cube map array storage.
+        //!
+        //! @param resolution the size of each face in pixels
+        //! @param cubes the number of cube maps
+        //! @param color the color mode
+        //! @param data the data type
+        //! @param levels the number of mipmap levels, 0 for the full chain
+        //! @param filter the filter mode
+        void allocate_cube_array(glm::uint resolution, glm::uint cubes, ColorMode color, DataType data, int levels = 0, FilterMode filter = FilterMode::LINEAR) noexcept;
+
+        //! Upload a layer of an allocated array or 3D texture.
+        //!
+        //! For cube map arrays the layer is cube * 6 + face.
+        //!
+        //! @param layer the layer or depth slice
+        //! @param level the mipmap level
+        //! @param bits the memory to upload, in the texture's color mode and data type
+        void upload_layer(glm::uint layer, int level, const void* bits) noexcept;
+
+        //! Upload a mipmap level of an allocated 2D texture.
+        //!
+        //! @param level the mipmap level
+        //! @param bits the memory to upload, in the texture's color mode and data type
+        void upload_level(int level, const void* bits) noexcept;
+
+        //! Upload a mipmap level of an allocated cube map face.
+        //!
+        //! @param face the cube map face
+        //! @param level the mipmap level
+        //! @param bits the memory to upload, in the texture's color mode and data type
+        void upload_level(CubeFace face, int level, const void* bits) noexcept;
+
+        //! Upload a compressed 2D texture.
+        //!
+        //! @param size the size in pixels
+        //! @param format the compressed format
+        //! @param srgb use the sRGB variant of the format
+        //! @param bits the compressed blocks to upload
+        //! @param filter the filter mode
+        //! @param wrap the wrapping mode
+        void upload_compressed_2d(glm::uvec2 size, CompressedFormat format, bool srgb, const void* bits, FilterMode filter = FilterMode::LINEAR, WrapMode wrap = WrapMode::REPEAT) noexcept;
+
+        //! Allocate immutable compressed 2D texture storage.
+        //!
+        //! @param size the size in pixels
+        //! @param format the compressed format
+        //! @param srgb use the sRGB variant of the format
+        //! @param levels the number of mipmap levels, 0 for the full chain
+        //! @param filter the filter mode
+        //! @param wrap the wrapping mode
+        void allocate_compressed_2d(glm::uvec2 size, CompressedFormat format, bool srgb, int levels = 0, FilterMode filter = FilterMode::LINEAR, WrapMode wrap = WrapMode::REPEAT) noexcept;
+
+        //! Allocate immutable compressed cube map storage.
+        //!
+        //! @param resolution the size of each face in pixels
+        //! @param format the compressed format
+        //! @param srgb use the sRGB variant of the format
+        //! @param levels the number of mipmap levels, 0 for the full chain
+        //! @param filter the filter mode
+        void allocate_compressed_cube(glm::uint resolution, CompressedFormat format, bool srgb, int levels = 0, FilterMode filter = FilterMode::LINEAR) noexcept;
+
+        //! Upload a mipmap level of an allocated compressed 2D texture.
+        //!
+        //! @param level the mipmap level
+        //! @param bits the compressed blocks to upload
+        void upload_compressed_level(int level, const void* bits) noexcept;
+
+        //! Upload a mipmap level of an allocated compressed cube map face.
+        //!
+        //! @param face the cube map face
+        //! @param level the mipmap level
+        //! @param bits the compressed blocks to upload
+        void upload_compressed_level(CubeFace face, int level, const void* bits) noexcept;
+
+        //! Get the compressed format.
+        //!
+        //! @return the compressed format or NONE for uncompressed textures
+        CompressedFormat get_compressed_format() const noexcept;
+
+        //! Update a region of a 2D texture.
+        //!
+        //! Only the region is transfered, the storage, filter and wrap
+        //! state of the texture are left untouched.
+        //!
+        //! @param offset the offset of the region in pixels
+        //! @param region the size of the region in pixels
+        //! @param level the mipmap level
+        //! @param bits the memory to upload, in the texture's color mode and data type
+        //! @param row_length the length of a row in pixels, 0 for tightly packed rows
+        void update_region(glm::uvec2 offset, glm::uvec2 region, int level, const void* bits, glm::uint row_length = 0u) noexcept;
+
+        //! Update a region of a cube map face.
+        //!
+        //! @param face the cube map face
+        //! @param offset the offset of the region in pixels
+        //! @param region the size of the region in pixels
+        //! @param level the mipmap level
+        //! @param bits the memory to upload, in the texture's color mode and data type
+        //! @param row_length the length of a row in pixels, 0 for tightly packed rows
+        void update_region(CubeFace face, glm::uvec2 offset, glm::uvec2 region, int level, const void* bits, glm::uint row_length = 0u) noexcept;
+
+        //! Set the base mipmap level.
+        //!
+        //! Levels above the base level are not sampled, this allows to
+        //! stream in the larger levels after the smaller ones.
+        //!
+        //! @param level the base mipmap level
+        //! @{
+        void set_base_level(int level) noexcept;
+        int get_base_level() const noexcept;
+        //! @}
+
         //! Ask OpenGL to generate mipmaps for this texture.
+        //!
+        //! A linear or nearest minification filter is switched to its
+        //! mipmapped variant, the rest of the sampling state is kept.
         void generate_mipmaps() noexcept;
 
         //! Get the total mipmap levels for this texture.
         int get_mipmap_levels() const noexcept;
 
+        //! Read a level back.
+        //!
+        //! This blocks until the GPU finished rendering to the texture,
+        //! use PixelReader to read without stalling.
+        //!
+        //! @param level the mipmap level
+        //! @return the pixels in the texture's color mode and data type
+        std::vector<std::byte> read_pixels(int level = 0) const noexcept;
+
+        //! Read a level of a cube map face back.
+        //!
+        //! @param face the cube map face
+        //! @param level the mipmap level
+        //! @return the pixels in the texture's color mode and data type
+        std::vector<std::byte> read_pixels(CubeFace face, int level = 0) const noexcept;
+
+        //! Get the memory used by the texture.
+        //!
+        //! @return the size of all levels, faces and layers in bytes
+        size_t get_memory_size() const noexcept;
+
+        //! Get the bindless handle.
+        //!
+        //! The handle is created on first use, after that the texture's
+        //! storage and sampling state can not be changed. The handle must
+        //! be made resident through TextureResidency before it is used.
+        //!
+        //! @return the handle or 0 if ARB_bindless_texture is not available
+        std::uint64_t get_handle() noexcept;
+
+        //! Check if the bindless handle is resident.
+        bool is_resident() const noexcept;
+
     private:
-        TextureType  type  = TextureType::NO_TEXTURE;
-        glm::uint    glid  = 0u;
-        glm::uvec2   size  = {0u, 0u};
-        ColorMode    color = ColorMode::UNKNOWN;
-        DataType     data  = DataType::UNKNOWN;
+        std::string      label;
+        TextureType      type       = TextureType::NO_TEXTURE;
+        glm::uint        glid       = 0u;
+        glm::uvec2       size       = {0u, 0u};
+        ColorMode        color      = ColorMode::UNKNOWN;
+        DataType         data       = DataType::UNKNOWN;
+        CompressedFormat compressed = CompressedFormat::NONE;
+        bool             srgb       = false;
+        glm::uint        layers     = 1u;
+        int              levels     = 1;
+        int              base_level = 0;
+        bool             immutable  = false;
+
+        glm::uint        last_slot  = 0;
+
+        std::uint64_t    handle     = 0u;
+        TextureResidency* residency = nullptr;
 
-        glm::uint    last_slot = 0;
+        void create(unsigned int target) noexcept;
+        void bind_unit(glm::uint slot) noexcept;
+        void write_region(unsigned int target, int level, glm::uvec2 offset, glm::uvec2 region, const void* bits, glm::uint row_length = 0u) noexcept;
+        void write_compressed_level(unsigned int target, int level, const void* bits) noexcept;
+        void read_level(unsigned int target, int level, void* bits) const noexcept;
 
         Texture(const Texture&) = delete;
         const Texture& operator = (const Texture&) = delete;
 
     friend class FrameBuffer;
+    friend class TextureUploader;
+    friend class TextureResidency;
+    friend class PixelReader;
     };
 }
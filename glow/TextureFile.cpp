@@ -0,0 +1,623 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "TextureFile.h"
+#include "util.h"
+
+#include <bit>
+#include <cstring>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace glow
+{
+    struct FileFormat
+    {
+        CompressedFormat compressed = CompressedFormat::NONE;
+        ColorMode        color      = ColorMode::UNKNOWN;
+        DataType         data       = DataType::UNKNOWN;
+        bool             srgb       = false;
+    };
+
+    constexpr auto KTX2_MAGIC = std::array<unsigned char, 12>{0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+    struct Ktx2Header
+    {
+        std::uint32_t vk_format;
+        std::uint32_t type_size;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t depth;
+        std::uint32_t layer_count;
+        std::uint32_t face_count;
+        std::uint32_t level_count;
+        std::uint32_t supercompression;
+    };
+
+    struct Ktx2Level
+    {
+        std::uint64_t offset;
+        std::uint64_t length;
+        std::uint64_t uncompressed_length;
+    };
+
+    // the level index follows the identifier, header and data format index
+    constexpr auto KTX2_HEADER_OFFSET = size_t{12};
+    constexpr auto KTX2_LEVEL_OFFSET  = size_t{80};
+
+    FileFormat get_vk_format(std::uint32_t format)
+    {
+        switch (format)
+        {
+        case 9:   return {CompressedFormat::NONE, ColorMode::R, DataType::UINT8};
+        case 16:  return {CompressedFormat::NONE, ColorMode::RG, DataType::UINT8};
+        case 23:  return {CompressedFormat::NONE, ColorMode::RGB, DataType::UINT8};
+        case 30:  return {CompressedFormat::NONE, ColorMode::BGR, DataType::UINT8};
+        case 37:  return {CompressedFormat::NONE, ColorMode::RGBA, DataType::UINT8};
+        case 44:  return {CompressedFormat::NONE, ColorMode::BGRA, DataType::UINT8};
+        case 100: return {CompressedFormat::NONE, ColorMode::R, DataType::FLOAT};
+        case 103: return {CompressedFormat::NONE, ColorMode::RG, DataType::FLOAT};
+        case 106: return {CompressedFormat::NONE, ColorMode::RGB, DataType::FLOAT};
+        case 109: return {CompressedFormat::NONE, ColorMode::RGBA, DataType::FLOAT};
+        case 131: return {CompressedFormat::BC1_RGB};
+        case 132: return {CompressedFormat::BC1_RGB, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 133: return {CompressedFormat::BC1_RGBA};
+        case 134: return {CompressedFormat::BC1_RGBA, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 135: return {CompressedFormat::BC2};
+        case 136: return {CompressedFormat::BC2, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 137: return {CompressedFormat::BC3};
+        case 138: return {CompressedFormat::BC3, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 139: return {CompressedFormat::BC4};
+        case 141: return {CompressedFormat::BC5};
+        case 143: return {CompressedFormat::BC6H};
+        case 144: return {CompressedFormat::BC6H_SIGNED};
+        case 145: return {CompressedFormat::BC7};
+        case 146: return {CompressedFormat::BC7, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 147: return {CompressedFormat::ETC2_RGB};
+        case 148: return {CompressedFormat::ETC2_RGB, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 151: return {CompressedFormat::ETC2_RGBA};
+        case 152: return {CompressedFormat::ETC2_RGBA, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 157: return {CompressedFormat::ASTC_4x4};
+        case 158: return {CompressedFormat::ASTC_4x4, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 161: return {CompressedFormat::ASTC_5x5};
+        case 162: return {CompressedFormat::ASTC_5x5, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 165: return {CompressedFormat::ASTC_6x6};
+        case 166: return {CompressedFormat::ASTC_6x6, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 171: return {CompressedFormat::ASTC_8x8};
+        case 172: return {CompressedFormat::ASTC_8x8, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 179: return {CompressedFormat::ASTC_10x10};
+        case 180: return {CompressedFormat::ASTC_10x10, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 183: return {CompressedFormat::ASTC_12x12};
+        case 184: return {CompressedFormat::ASTC_12x12, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        default:
+            throw std::runtime_error("Unsupported KTX2 format " + std::to_string(format) + ".");
+        }
+    }
+
+    struct DdsPixelFormat
+    {
+        std::uint32_t size;
+        std::uint32_t flags;
+        std::uint32_t four_cc;
+        std::uint32_t bit_count;
+        std::uint32_t r_mask;
+        std::uint32_t g_mask;
+        std::uint32_t b_mask;
+        std::uint32_t a_mask;
+    };
+
+    struct DdsHeader
+    {
+        std::uint32_t  size;
+        std::uint32_t  flags;
+        std::uint32_t  height;
+        std::uint32_t  width;
+        std::uint32_t  pitch;
+        std::uint32_t  depth;
+        std::uint32_t  mip_count;
+        std::uint32_t  reserved1[11];
+        DdsPixelFormat format;
+        std::uint32_t  caps;
+        std::uint32_t  caps2;
+        std::uint32_t  caps3;
+        std::uint32_t  caps4;
+        std::uint32_t  reserved2;
+    };
+
+    struct DdsHeader10
+    {
+        std::uint32_t dxgi_format;
+        std::uint32_t dimension;
+        std::uint32_t misc_flag;
+        std::uint32_t array_size;
+        std::uint32_t misc_flags2;
+    };
+
+    static_assert(sizeof(DdsHeader) == 124);
+
+    constexpr std::uint32_t fourcc(const char (&code)[5]) noexcept
+    {
+        return static_cast<std::uint32_t>(code[0]) | static_cast<std::uint32_t>(code[1]) << 8 |
+               static_cast<std::uint32_t>(code[2]) << 16 | static_cast<std::uint32_t>(code[3]) << 24;
+    }
+
+    constexpr auto DDPF_ALPHAPIXELS   = std::uint32_t{0x1};
+    constexpr auto DDPF_FOURCC        = std::uint32_t{0x4};
+    constexpr auto DDPF_RGB           = std::uint32_t{0x40};
+    constexpr auto DDSCAPS2_CUBEMAP   = std::uint32_t{0x200};
+    constexpr auto DDSCAPS2_ALLFACES  = std::uint32_t{0xFC00};
+    constexpr auto DDSCAPS2_VOLUME    = std::uint32_t{0x200000};
+
+    FileFormat get_dxgi_format(std::uint32_t format)
+    {
+        switch (format)
+        {
+        case 2:  return {CompressedFormat::NONE, ColorMode::RGBA, DataType::FLOAT};
+        case 6:  return {CompressedFormat::NONE, ColorMode::RGB, DataType::FLOAT};
+        case 16: return {CompressedFormat::NONE, ColorMode::RG, DataType::FLOAT};
+        case 28: return {CompressedFormat::NONE, ColorMode::RGBA, DataType::UINT8};
+        case 41: return {CompressedFormat::NONE, ColorMode::R, DataType::FLOAT};
+        case 49: return {CompressedFormat::NONE, ColorMode::RG, DataType::UINT8};
+        case 61: return {CompressedFormat::NONE, ColorMode::R, DataType::UINT8};
+        case 87: return {CompressedFormat::NONE, ColorMode::BGRA, DataType::UINT8};
+        case 71: return {CompressedFormat::BC1_RGBA};
+        case 72: return {CompressedFormat::BC1_RGBA, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 74: return {CompressedFormat::BC2};
+        case 75: return {CompressedFormat::BC2, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 77: return {CompressedFormat::BC3};
+        case 78: return {CompressedFormat::BC3, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        case 80: return {CompressedFormat::BC4};
+        case 83: return {CompressedFormat::BC5};
+        case 95: return {CompressedFormat::BC6H};
+        case 96: return {CompressedFormat::BC6H_SIGNED};
+        case 98: return {CompressedFormat::BC7};
+        case 99: return {CompressedFormat::BC7, ColorMode::UNKNOWN, DataType::UNKNOWN, true};
+        default:
+            throw std::runtime_error("Unsupported DXGI format " + std::to_string(format) + ".");
+        }
+    }
+
+    FileFormat get_dds_format(const DdsPixelFormat& format)
+    {
+        if ((format.flags & DDPF_FOURCC) != 0u)
+        {
+            switch (format.four_cc)
+            {
+            case fourcc("DXT1"):
+                return {CompressedFormat::BC1_RGBA};
+            case fourcc("DXT2"):
+            case fourcc("DXT3"):
+                return {CompressedFormat::BC2};
+            case fourcc("DXT4"):
+            case fourcc("DXT5"):
+                return {CompressedFormat::BC3};
+            case fourcc("ATI1"):
+            case fourcc("BC4U"):
+                return {CompressedFormat::BC4};
+            case fourcc("ATI2"):
+            case fourcc("BC5U"):
+                return {CompressedFormat::BC5};
+            default:
+                throw std::runtime_error("Unsupported DDS four cc code.");
+            }
+        }
+
+        if ((format.flags & DDPF_RGB) != 0u)
+        {
+            auto alpha = (format.flags & DDPF_ALPHAPIXELS) != 0u;
+            if (format.bit_count == 32u && alpha && format.r_mask == 0x000000FFu && format.b_mask == 0x00FF0000u)
+            {
+                return {CompressedFormat::NONE, ColorMode::RGBA, DataType::UINT8};
+            }
+            if (format.bit_count == 32u && alpha && format.r_mask == 0x00FF0000u && format.b_mask == 0x000000FFu)
+            {
+                return {CompressedFormat::NONE, ColorMode::BGRA, DataType::UINT8};
+            }
+            if (format.bit_count == 24u && format.r_mask == 0x000000FFu && format.b_mask == 0x00FF0000u)
+            {
+                return {CompressedFormat::NONE, ColorMode::RGB, DataType::UINT8};
+            }
+            if (format.bit_count == 24u && format.r_mask == 0x00FF0000u && format.b_mask == 0x000000FFu)
+            {
+                return {CompressedFormat::NONE, ColorMode::BGR, DataType::UINT8};
+            }
+        }
+
+        throw std::runtime_error("Unsupported DDS pixel format.");
+    }
+
+    template <typename T>
+    T read(const std::byte* memory, size_t length, size_t offset)
+    {
+        if (offset > length || sizeof(T) > length - offset)
+        {
+            throw std::runtime_error("Texture file is truncated.");
+        }
+
+        // the header is copied, as the mapping gives no alignment guarantee
+        auto value = T{};
+        std::memcpy(&value, memory + offset, sizeof(T));
+        return value;
+    }
+
+    TextureFile::TextureFile(const std::filesystem::path& file)
+    {
+        map(file);
+
+        try
+        {
+            if (length >= KTX2_MAGIC.size() && std::memcmp(memory, KTX2_MAGIC.data(), KTX2_MAGIC.size()) == 0)
+            {
+                parse_ktx2();
+            }
+            else if (length >= 4u && std::memcmp(memory, "DDS ", 4u) == 0)
+            {
+                parse_dds();
+            }
+            else
+            {
+                throw std::runtime_error("Unknown texture file format.");
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            unmap();
+            throw std::runtime_error(file.string() + ": " + ex.what());
+        }
+    }
+
+    TextureFile::~TextureFile()
+    {
+        unmap();
+    }
+
+    TextureType TextureFile::get_type() const noexcept
+    {
+        return type;
+    }
+
+    glm::uvec2 TextureFile::get_size() const noexcept
+    {
+        return size;
+    }
+
+    int TextureFile::get_levels() const noexcept
+    {
+        return levels;
+    }
+
+    ColorMode TextureFile::get_color_mode() const noexcept
+    {
+        return color;
+    }
+
+    DataType TextureFile::get_data_type() const noexcept
+    {
+        return data;
+    }
+
+    CompressedFormat TextureFile::get_compressed_format() const noexcept
+    {
+        return compressed;
+    }
+
+    bool TextureFile::is_srgb() const noexcept
+    {
+        return srgb;
+    }
+
+    std::span<const std::byte> TextureFile::get_data(int level, CubeFace face) const noexcept
+    {
+        GLOW_ASSERT(level >= 0 && level < levels);
+
+        if (type == TextureType::CUBE_MAP)
+        {
+            return images[level * 6 + static_cast<int>(face)];
+        }
+        return images[level];
+    }
+
+    void TextureFile::upload(Texture& texture, int first_level, FilterMode filter, WrapMode wrap) const noexcept
+    {
+        GLOW_DEBUG_GROUP("TextureFile::upload");
+        GLOW_ASSERT(first_level >= 0 && first_level < levels);
+
+        if (compressed != CompressedFormat::NONE)
+        {
+            if (type == TextureType::CUBE_MAP)
+            {
+                texture.allocate_compressed_cube(size.x, compressed, srgb, levels, filter);
+            }
+            else
+            {
+                texture.allocate_compressed_2d(size, compressed, srgb, levels, filter, wrap);
+            }
+        }
+        else
+        {
+            if (type == TextureType::CUBE_MAP)
+            {
+                texture.allocate_cube(size.x, color, data, levels, filter);
+            }
+            else
+            {
+                texture.allocate_2d(size, color, data, levels, filter, wrap);
+            }
+        }
+
+        for (auto level = levels - 1; level >= first_level; level--)
+        {
+            write_level(texture, level);
+        }
+        texture.set_base_level(first_level);
+    }
+
+    void TextureFile::upload_level(Texture& texture, int level) const noexcept
+    {
+        GLOW_DEBUG_GROUP("TextureFile::upload_level");
+        GLOW_ASSERT(level >= 0 && level < levels);
+        GLOW_ASSERT(texture.get_mipmap_levels() == levels);
+
+        write_level(texture, level);
+        if (level < texture.get_base_level())
+        {
+            texture.set_base_level(level);
+        }
+    }
+
+    void TextureFile::map(const std::filesystem::path& file)
+    {
+        #ifdef _WIN32
+        auto handle = CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Failed to open " + file.string() + ".");
+        }
+
+        auto file_size = LARGE_INTEGER{};
+        GetFileSizeEx(handle, &file_size);
+        length = static_cast<size_t>(file_size.QuadPart);
+
+        // the view keeps the file and mapping alive
+        auto mapping = length > 0u ? CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+        if (mapping != nullptr)
+        {
+            memory = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+        CloseHandle(handle);
+        #else
+        auto handle = open(file.c_str(), O_RDONLY);
+        if (handle < 0)
+        {
+            throw std::runtime_error("Failed to open " + file.string() + ".");
+        }
+
+        struct stat info = {};
+        fstat(handle, &info);
+        length = static_cast<size_t>(info.st_size);
+
+        // the mapping keeps the file alive
+        if (length > 0u)
+        {
+            auto view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, handle, 0);
+            memory = view != MAP_FAILED ? static_cast<const std::byte*>(view) : nullptr;
+        }
+        close(handle);
+        #endif
+
+        if (memory == nullptr)
+        {
+            length = 0u;
+            throw std::runtime_error("Failed to map " + file.string() + ".");
+        }
+    }
+
+    void TextureFile::unmap() noexcept
+    {
+        if (memory != nullptr)
+        {
+            #ifdef _WIN32
+            UnmapViewOfFile(memory);
+            #else
+            munmap(const_cast<std::byte*>(memory), length);
+            #endif
+            memory = nullptr;
+            length = 0u;
+        }
+        images.clear();
+    }
+
+    void TextureFile::parse_ktx2()
+    {
+        auto header = read<Ktx2Header>(memory, length, KTX2_HEADER_OFFSET);
+
+        if (header.supercompression != 0u)
+        {
+            throw std::runtime_error("Supercompressed KTX2 files are not supported.");
+        }
+        if (header.width == 0u || header.height == 0u || header.depth != 0u || header.layer_count != 0u)
+        {
+            throw std::runtime_error("Only 2D textures and cube maps are supported.");
+        }
+        if (header.face_count != 1u && header.face_count != 6u)
+        {
+            throw std::runtime_error("Invalid KTX2 face count.");
+        }
+
+        auto format = get_vk_format(header.vk_format);
+        compressed = format.compressed;
+        color      = format.color;
+        data       = format.data;
+        srgb       = format.srgb;
+        type       = header.face_count == 6u ? TextureType::CUBE_MAP : TextureType::TEXTURE2D;
+        size       = {header.width, header.height};
+        levels     = static_cast<int>(std::max(header.level_count, 1u));
+        check_levels();
+
+        auto faces = static_cast<size_t>(header.face_count);
+        images.reserve(levels * faces);
+        for (auto level = 0; level < levels; level++)
+        {
+            auto index = read<Ktx2Level>(memory, length, KTX2_LEVEL_OFFSET + level * sizeof(Ktx2Level));
+            if (index.offset > length || index.length > length - index.offset)
+            {
+                throw std::runtime_error("KTX2 level exceeds the file.");
+            }
+
+            // the faces of a level follow each other
+            auto face_size = static_cast<size_t>(index.length) / faces;
+            if (face_size < get_image_size(level))
+            {
+                throw std::runtime_error("KTX2 level is too small.");
+            }
+
+            for (auto face = size_t{0}; face < faces; face++)
+            {
+                images.emplace_back(memory + index.offset + face * face_size, face_size);
+            }
+        }
+    }
+
+    void TextureFile::parse_dds()
+    {
+        auto header = read<DdsHeader>(memory, length, 4u);
+        auto offset = size_t{4} + sizeof(DdsHeader);
+
+        if ((header.caps2 & DDSCAPS2_VOLUME) != 0u)
+        {
+            throw std::runtime_error("Volume textures are not supported.");
+        }
+
+        auto format = FileFormat{};
+        if ((header.format.flags & DDPF_FOURCC) != 0u && header.format.four_cc == fourcc("DX10"))
+        {
+            auto header10 = read<DdsHeader10>(memory, length, offset);
+            offset += sizeof(DdsHeader10);
+            if (header10.array_size > 1u)
+            {
+                throw std::runtime_error("Texture arrays are not supported.");
+            }
+            format = get_dxgi_format(header10.dxgi_format);
+        }
+        else
+        {
+            format = get_dds_format(header.format);
+        }
+
+        auto cube = (header.caps2 & DDSCAPS2_CUBEMAP) != 0u;
+        if (cube && (header.caps2 & DDSCAPS2_ALLFACES) != DDSCAPS2_ALLFACES)
+        {
+            throw std::runtime_error("Partial cube maps are not supported.");
+        }
+        if (header.width == 0u || header.height == 0u)
+        {
+            throw std::runtime_error("Invalid DDS size.");
+        }
+
+        compressed = format.compressed;
+        color      = format.color;
+        data       = format.data;
+        srgb       = format.srgb;
+        type       = cube ? TextureType::CUBE_MAP : TextureType::TEXTURE2D;
+        size       = {header.width, header.height};
+        levels     = static_cast<int>(std::max(header.mip_count, 1u));
+        check_levels();
+
+        // DDS stores the levels of each face after another
+        auto faces = cube ? size_t{6} : size_t{1};
+        images.resize(levels * faces);
+        for (auto face = size_t{0}; face < faces; face++)
+        {
+            for (auto level = 0; level < levels; level++)
+            {
+                auto image_size = get_image_size(level);
+                if (image_size > length - offset)
+                {
+                    throw std::runtime_error("DDS level exceeds the file.");
+                }
+
+                images[level * faces + face] = {memory + offset, image_size};
+                offset += image_size;
+            }
+        }
+    }
+
+    void TextureFile::check_levels() const
+    {
+        auto full_levels = static_cast<int>(std::bit_width(std::max(size.x, size.y)));
+        if (levels < 1 || levels > full_levels)
+        {
+            throw std::runtime_error("Invalid mipmap level count.");
+        }
+    }
+
+    size_t TextureFile::get_image_size(int level) const noexcept
+    {
+        auto level_size = glm::uvec2(std::max(size.x >> level, 1u), std::max(size.y >> level, 1u));
+        if (compressed != CompressedFormat::NONE)
+        {
+            return get_compressed_size(compressed, level_size);
+        }
+        return size_t{level_size.x} * size_t{level_size.y} * get_pixel_size(color, data);
+    }
+
+    void TextureFile::write_level(Texture& texture, int level) const noexcept
+    {
+        if (type == TextureType::CUBE_MAP)
+        {
+            for (auto i = 0; i < 6; i++)
+            {
+                auto face = static_cast<CubeFace>(i);
+                auto bits = get_data(level, face).data();
+                if (compressed != CompressedFormat::NONE)
+                {
+                    texture.upload_compressed_level(face, level, bits);
+                }
+                else
+                {
+                    texture.upload_level(face, level, bits);
+                }
+            }
+        }
+        else
+        {
+            auto bits = get_data(level).data();
+            if (compressed != CompressedFormat::NONE)
+            {
+                texture.upload_compressed_level(level, bits);
+            }
+            else
+            {
+                texture.upload_level(level, bits);
+            }
+        }
+    }
+}
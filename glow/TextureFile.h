@@ -0,0 +1,134 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "defines.h"
+#include "Texture.h"
+
+namespace glow
+{
+    //! Texture File
+    //!
+    //! The texture file reads KTX2 and DDS containers. The file is memory
+    //! mapped and only the header and level index are parsed, the image
+    //! data is handed to the texture straight out of the mapping.
+    //!
+    //! Files are uploaded into immutable storage, compressed or not. To
+    //! stream a texture progressively, upload the small levels first
+    //! and add the larger levels later with upload_level.
+    //!
+    //! Supercompressed KTX2 files, texture arrays and volume textures
+    //! are not supported.
+    class GLOW_EXPORT TextureFile
+    {
+    public:
+        //! Open a texture file.
+        //!
+        //! @param file the KTX2 or DDS file
+        //!
+        //! @throws std::runtime_error if the file can not be read or the
+        //! format is not supported
+        TextureFile(const std::filesystem::path& file);
+
+        //! Close texture file.
+        ~TextureFile();
+
+        //! Get the texture type.
+        TextureType get_type() const noexcept;
+
+        //! Get the size of the largest level in pixels.
+        glm::uvec2 get_size() const noexcept;
+
+        //! Get the number of mipmap levels.
+        int get_levels() const noexcept;
+
+        //! Get the color mode of an uncompressed file.
+        ColorMode get_color_mode() const noexcept;
+
+        //! Get the data type of an uncompressed file.
+        DataType get_data_type() const noexcept;
+
+        //! Get the compressed format.
+        //!
+        //! @return the compressed format, NONE for uncompressed files
+        CompressedFormat get_compressed_format() const noexcept;
+
+        //! Check if the file holds sRGB data.
+        bool is_srgb() const noexcept;
+
+        //! Get the image data of a level.
+        //!
+        //! @param level the mipmap level
+        //! @param face the cube map face, ignored for 2D textures
+        //! @return the image data inside the mapping
+        std::span<const std::byte> get_data(int level, CubeFace face = CubeFace::XPOS) const noexcept;
+
+        //! Upload the file into a texture.
+        //!
+        //! Allocates storage for all levels, but only uploads the levels
+        //! from first_level on and makes it the base level.
+        //!
+        //! @param texture the texture to upload to
+        //! @param first_level the largest level to upload
+        //! @param filter the filter mode
+        //! @param wrap the wrapping mode, ignored for cube maps
+        void upload(Texture& texture, int first_level = 0, FilterMode filter = FilterMode::LINEAR, WrapMode wrap = WrapMode::REPEAT) const noexcept;
+
+        //! Upload a level into a texture that was loaded from this file.
+        //!
+        //! If the level is larger than the base level of the texture
+        //! it becomes the new base level.
+        //!
+        //! @param texture the texture to upload to
+        //! @param level the mipmap level
+        void upload_level(Texture& texture, int level) const noexcept;
+
+    private:
+        const std::byte* memory     = nullptr;
+        size_t           length     = 0u;
+
+        TextureType      type       = TextureType::NO_TEXTURE;
+        glm::uvec2       size       = {0u, 0u};
+        ColorMode        color      = ColorMode::UNKNOWN;
+        DataType         data       = DataType::UNKNOWN;
+        CompressedFormat compressed = CompressedFormat::NONE;
+        bool             srgb       = false;
+        int              levels     = 0;
+        // one range per level and face, level major
+        std::vector<std::span<const std::byte>> images;
+
+        void map(const std::filesystem::path& file);
+        void unmap() noexcept;
+        void parse_ktx2();
+        void parse_dds();
+        void check_levels() const;
+        size_t get_image_size(int level) const noexcept;
+        void write_level(Texture& texture, int level) const noexcept;
+
+        TextureFile(const TextureFile&) = delete;
+        TextureFile& operator = (const TextureFile&) = delete;
+    };
+}
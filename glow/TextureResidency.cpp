@@ -0,0 +1,146 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "TextureResidency.h"
+#include "Texture.h"
+#include "util.h"
+
+namespace glow
+{
+    TextureResidency::TextureResidency(size_t b)
+    : budget(b) {}
+
+    TextureResidency::~TextureResidency()
+    {
+        for (auto& [texture, entry] : entries)
+        {
+            glMakeTextureHandleNonResidentARB(texture->handle);
+            texture->residency = nullptr;
+        }
+        entries.clear();
+        GLOW_CHECK_GLERROR();
+    }
+
+    bool TextureResidency::is_supported() noexcept
+    {
+        return GLEW_ARB_bindless_texture;
+    }
+
+    void TextureResidency::set_budget(size_t value) noexcept
+    {
+        budget = value;
+        evict();
+    }
+
+    size_t TextureResidency::get_budget() const noexcept
+    {
+        return budget;
+    }
+
+    size_t TextureResidency::get_resident_size() const noexcept
+    {
+        return resident_size;
+    }
+
+    size_t TextureResidency::get_resident_count() const noexcept
+    {
+        return entries.size();
+    }
+
+    unsigned int TextureResidency::get_evictions() const noexcept
+    {
+        return evictions;
+    }
+
+    void TextureResidency::begin_frame() noexcept
+    {
+        frame++;
+    }
+
+    std::uint64_t TextureResidency::make_resident(Texture& texture) noexcept
+    {
+        if (!is_supported())
+        {
+            return 0u;
+        }
+
+        if (auto i = entries.find(&texture); i != end(entries))
+        {
+            i->second.frame = frame;
+            return texture.handle;
+        }
+
+        GLOW_ASSERT(texture.residency == nullptr);
+
+        auto handle = texture.get_handle();
+        glMakeTextureHandleResidentARB(handle);
+        GLOW_CHECK_GLERROR();
+
+        auto size = texture.get_memory_size();
+        entries[&texture] = {size, frame};
+        texture.residency = this;
+        resident_size += size;
+
+        evict();
+        return handle;
+    }
+
+    void TextureResidency::release(Texture& texture) noexcept
+    {
+        auto i = entries.find(&texture);
+        if (i == end(entries))
+        {
+            return;
+        }
+
+        glMakeTextureHandleNonResidentARB(texture.handle);
+        GLOW_CHECK_GLERROR();
+
+        resident_size -= i->second.size;
+        texture.residency = nullptr;
+        entries.erase(i);
+    }
+
+    void TextureResidency::evict() noexcept
+    {
+        while (resident_size > budget)
+        {
+            auto oldest = end(entries);
+            for (auto i = begin(entries); i != end(entries); ++i)
+            {
+                if (i->second.frame < frame && (oldest == end(entries) || i->second.frame < oldest->second.frame))
+                {
+                    oldest = i;
+                }
+            }
+
+            if (oldest == end(entries))
+            {
+                // everything is used this frame
+                return;
+            }
+
+            release(*oldest->first);
+            evictions++;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "defines.h"
+
+namespace glow
+{
+    class Texture;
+
+    //! Texture Residency
+    //!
+    //! The texture residency manager makes bindless texture handles
+    //! resident and keeps the resident textures under a memory budget.
+    //!
+    //! Each frame the textures that are drawn are requested with
+    //! make_resident. When the budget is exceeded the textures that
+    //! were not requested for the longest time are made non-resident.
+    //! Textures requested in the current frame are never evicted, so
+    //! the budget may be exceeded if a single frame needs more.
+    //!
+    //! The returned handles can be set with Shader::set_uniform or
+    //! written into uniform and storage buffers with
+    //! UniformBuffer::set_handle. Shaders see GLOW_BINDLESS defined when
+    //! the extension is available.
+    //!
+    //! If ARB_bindless_texture is not available make_resident returns
+    //! 0 and textures must be bound to slots as before.
+    class GLOW_EXPORT TextureResidency
+    {
+    public:
+        //! Create a residency manager.
+        //!
+        //! @param budget the memory budget in bytes
+        TextureResidency(size_t budget);
+
+        //! Make all textures non-resident.
+        ~TextureResidency();
+
+        //! Check if bindless textures are supported.
+        static bool is_supported() noexcept;
+
+        //! Memory budget in bytes.
+        //!
+        //! @{
+        void set_budget(size_t value) noexcept;
+        size_t get_budget() const noexcept;
+        //! @}
+
+        //! Get the memory used by resident textures in bytes.
+        size_t get_resident_size() const noexcept;
+
+        //! Get the number of resident textures.
+        size_t get_resident_count() const noexcept;
+
+        //! Get the number of textures evicted so far.
+        unsigned int get_evictions() const noexcept;
+
+        //! Start a new frame.
+        void begin_frame() noexcept;
+
+        //! Make a texture resident for the current frame.
+        //!
+        //! @param texture the texture to use
+        //! @return the bindless handle or 0 if not supported
+        std::uint64_t make_resident(Texture& texture) noexcept;
+
+        //! Make a texture non-resident and forget it.
+        //!
+        //! @param texture the texture to release
+        void release(Texture& texture) noexcept;
+
+    private:
+        struct Entry
+        {
+            size_t        size  = 0u;
+            std::uint64_t frame = 0u;
+        };
+
+        size_t        budget        = 0u;
+        size_t        resident_size = 0u;
+        std::uint64_t frame         = 0u;
+        unsigned int  evictions     = 0u;
+        std::unordered_map<Texture*, Entry> entries;
+
+        void evict() noexcept;
+
+        TextureResidency(const TextureResidency&) = delete;
+        TextureResidency& operator = (const TextureResidency&) = delete;
+    };
+}
@@ -0,0 +1,249 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "TextureUploader.h"
+#include "util.h"
+
+namespace glow
+{
+    constexpr auto UPLOAD_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    // keeps every range aligned for any pixel size
+    constexpr auto UPLOAD_ALIGNMENT = size_t{16};
+
+    // one second
+    constexpr auto UPLOAD_TIMEOUT = GLuint64{1000000000};
+
+    TextureUploader::TextureUploader(size_t s)
+    : size(s)
+    {
+        GLOW_ASSERT(size > 0u);
+
+        persistent = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+
+        glGenBuffers(1, &glid);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, glid);
+        if (persistent)
+        {
+            glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, UPLOAD_FLAGS);
+            memory = static_cast<std::byte*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, UPLOAD_FLAGS));
+        }
+        else
+        {
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+            shadow.resize(size);
+            memory = shadow.data();
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (memory == nullptr)
+        {
+            glDeleteBuffers(1, &glid);
+            glid = 0u;
+            throw std::runtime_error("Failed to map texture upload buffer.");
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    TextureUploader::~TextureUploader()
+    {
+        wait_all();
+
+        for (const auto& block : blocks)
+        {
+            if (block.fence != nullptr)
+            {
+                glDeleteSync(static_cast<GLsync>(block.fence));
+            }
+        }
+
+        if (glid != 0)
+        {
+            if (persistent)
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, glid);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+            glDeleteBuffers(1, &glid);
+            glid = 0;
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    bool TextureUploader::is_persistent() const noexcept
+    {
+        return persistent;
+    }
+
+    size_t TextureUploader::get_size() const noexcept
+    {
+        return size;
+    }
+
+    size_t TextureUploader::get_pending() const noexcept
+    {
+        return blocks.size();
+    }
+
+    UploadRange TextureUploader::stage(size_t s) noexcept
+    {
+        GLOW_ASSERT(s > 0u);
+
+        auto start = (head + UPLOAD_ALIGNMENT - 1u) / UPLOAD_ALIGNMENT * UPLOAD_ALIGNMENT;
+        if (blocks.empty())
+        {
+            if (start + s > size)
+            {
+                start = 0u;
+            }
+        }
+        else
+        {
+            auto tail = blocks.front().offset;
+            if (start > tail)
+            {
+                // free space at the end and before the tail
+                if (start + s > size)
+                {
+                    start = 0u;
+                }
+            }
+            if (start <= tail && start + s > tail)
+            {
+                return {};
+            }
+        }
+
+        if (start + s > size)
+        {
+            return {};
+        }
+
+        if (start < head)
+        {
+            orphan = !persistent;
+        }
+
+        head = start + s;
+        blocks.push_back({start, s});
+
+        return {memory + start, start, s};
+    }
+
+    UploadRange TextureUploader::stage(const Texture& texture, glm::uvec2 region) noexcept
+    {
+        return stage(size_t{region.x} * size_t{region.y} * get_pixel_size(texture.color, texture.data));
+    }
+
+    void TextureUploader::upload(const UploadRange& range, Texture& texture, int level, glm::uvec2 offset, glm::uvec2 region) noexcept
+    {
+        GLOW_DEBUG_GROUP("TextureUploader::upload");
+        GLOW_ASSERT(texture.type == TextureType::TEXTURE2D);
+        write(range, texture, GL_TEXTURE_2D, level, offset, region);
+    }
+
+    void TextureUploader::upload(const UploadRange& range, Texture& texture, CubeFace face, int level, glm::uvec2 offset, glm::uvec2 region) noexcept
+    {
+        GLOW_DEBUG_GROUP("TextureUploader::upload");
+        GLOW_ASSERT(texture.type == TextureType::CUBE_MAP);
+        write(range, texture, GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(face), level, offset, region);
+    }
+
+    size_t TextureUploader::poll() noexcept
+    {
+        while (!blocks.empty() && blocks.front().uploaded)
+        {
+            auto& block = blocks.front();
+            if (block.fence != nullptr)
+            {
+                auto fence  = static_cast<GLsync>(block.fence);
+                auto result = glClientWaitSync(fence, 0, 0);
+                GLOW_ASSERT(result != GL_WAIT_FAILED);
+                if (result == GL_TIMEOUT_EXPIRED)
+                {
+                    break;
+                }
+                glDeleteSync(fence);
+            }
+            blocks.pop_front();
+        }
+
+        GLOW_CHECK_GLERROR();
+        return blocks.size();
+    }
+
+    void TextureUploader::wait_all() noexcept
+    {
+        for (auto& block : blocks)
+        {
+            if (block.fence != nullptr)
+            {
+                auto fence  = static_cast<GLsync>(block.fence);
+                auto result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UPLOAD_TIMEOUT);
+                while (result == GL_TIMEOUT_EXPIRED)
+                {
+                    result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UPLOAD_TIMEOUT);
+                }
+                GLOW_ASSERT(result != GL_WAIT_FAILED);
+            }
+        }
+        poll();
+    }
+
+    void TextureUploader::write(const UploadRange& range, Texture& texture, unsigned int target, int level, glm::uvec2 offset, glm::uvec2 region) noexcept
+    {
+        GLOW_ASSERT(glid != 0);
+        GLOW_ASSERT(range.is_valid());
+        GLOW_ASSERT(size_t{region.x} * size_t{region.y} * get_pixel_size(texture.color, texture.data) <= range.size);
+
+        auto i = std::find_if(begin(blocks), end(blocks), [&] (const Block& block) {
+            return block.offset == range.offset && !block.uploaded;
+        });
+        GLOW_ASSERT(i != end(blocks));
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, glid);
+        if (!persistent)
+        {
+            if (orphan)
+            {
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+                orphan = false;
+            }
+            glBufferSubData(GL_PIXEL_UNPACK_BUFFER, range.offset, range.size, range.data);
+        }
+
+        // with a pixel unpack buffer bound the pointer is an offset into the buffer
+        texture.write_region(target, level, offset, region, reinterpret_cast<const void*>(range.offset));
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (persistent)
+        {
+            i->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+        i->uploaded = true;
+
+        GLOW_CHECK_GLERROR();
+    }
+}
@@ -0,0 +1,160 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "defines.h"
+#include "Texture.h"
+
+namespace glow
+{
+    //! Staging range of a texture uploader.
+    struct UploadRange
+    {
+        //! The mapped memory to write to.
+        void*  data   = nullptr;
+        //! The offset in bytes from the start of the buffer.
+        size_t offset = 0u;
+        //! The size in bytes.
+        size_t size   = 0u;
+
+        //! Check if the staging succeeded.
+        bool is_valid() const noexcept
+        {
+            return data != nullptr;
+        }
+    };
+
+    //! Texture Uploader
+    //!
+    //! The texture uploader streams pixel data into textures through a
+    //! ring of pixel buffer memory, so that the render thread neither
+    //! copies the pixels nor waits on the driver.
+    //!
+    //! An upload happens in three steps. First stage reserves memory in
+    //! the ring on the render thread. Then the pixels are written into
+    //! the returned range, this may happen on any thread. Finally upload
+    //! issues glTexSubImage2D from the pixel buffer and fences the
+    //! range. Once the GPU passed the fence, poll returns the memory to
+    //! the ring.
+    //!
+    //! If OpenGL 4.4 or ARB_buffer_storage is available the ring is
+    //! persistently mapped and written directly. Otherwise the ring is
+    //! shadowed in client memory, copied on upload and the buffer is
+    //! orphaned every time the ring wraps around.
+    //!
+    //! @note All functions must be called on the thread that owns the
+    //! context. Only writing into a staged range may happen on other
+    //! threads and must be complete before calling upload.
+    class GLOW_EXPORT TextureUploader
+    {
+    public:
+        //! Create a texture uploader.
+        //!
+        //! @param size the size of the ring in bytes
+        TextureUploader(size_t size);
+
+        //! Release texture uploader.
+        //!
+        //! Waits for all uploads in flight.
+        ~TextureUploader();
+
+        //! Check if the ring is persistently mapped.
+        bool is_persistent() const noexcept;
+
+        //! Get the size of the ring in bytes.
+        size_t get_size() const noexcept;
+
+        //! Get the number of staged ranges that where not retired yet.
+        size_t get_pending() const noexcept;
+
+        //! Stage memory for an upload.
+        //!
+        //! @param size the size in bytes
+        //! @return the staged range, invalid if the ring is full
+        UploadRange stage(size_t size) noexcept;
+
+        //! Stage memory for a region of a texture.
+        //!
+        //! The pixels are expected to be tightly packed rows in the
+        //! color mode and data type of the texture.
+        //!
+        //! @param texture the texture to upload to
+        //! @param region the size of the region in pixels
+        //! @return the staged range, invalid if the ring is full
+        UploadRange stage(const Texture& texture, glm::uvec2 region) noexcept;
+
+        //! Upload a staged range into a 2D texture.
+        //!
+        //! @param range the staged range holding the pixels
+        //! @param texture the texture to upload to
+        //! @param level the mipmap level
+        //! @param offset the offset of the region in pixels
+        //! @param region the size of the region in pixels
+        void upload(const UploadRange& range, Texture& texture, int level, glm::uvec2 offset, glm::uvec2 region) noexcept;
+
+        //! Upload a staged range into a cube map face.
+        //!
+        //! @param range the staged range holding the pixels
+        //! @param texture the texture to upload to
+        //! @param face the cube map face
+        //! @param level the mipmap level
+        //! @param offset the offset of the region in pixels
+        //! @param region the size of the region in pixels
+        void upload(const UploadRange& range, Texture& texture, CubeFace face, int level, glm::uvec2 offset, glm::uvec2 region) noexcept;
+
+        //! Retire all completed uploads.
+        //!
+        //! @return the number of staged ranges still pending
+        size_t poll() noexcept;
+
+        //! Wait until all uploads are completed.
+        //!
+        //! @note Ranges that where staged but not uploaded stay pending.
+        void wait_all() noexcept;
+
+    private:
+        struct Block
+        {
+            size_t offset   = 0u;
+            size_t size     = 0u;
+            void*  fence    = nullptr;
+            bool   uploaded = false;
+        };
+
+        glm::uint               glid       = 0u;
+        std::byte*              memory     = nullptr;
+        std::vector<std::byte>  shadow;
+        size_t                  size       = 0u;
+        size_t                  head       = 0u;
+        bool                    persistent = false;
+        bool                    orphan     = false;
+        std::deque<Block>       blocks;
+
+        void write(const UploadRange& range, Texture& texture, unsigned int target, int level, glm::uvec2 offset, glm::uvec2 region) noexcept;
+
+        TextureUploader(const TextureUploader&) = delete;
+        TextureUploader& operator = (const TextureUploader&) = delete;
+    };
+}
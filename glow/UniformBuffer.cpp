@@ -0,0 +1,440 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "UniformBuffer.h"
+#include "util.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace glow
+{
+    constexpr GLenum get_gl_target(BlockType type) noexcept
+    {
+        switch (type)
+        {
+        case BlockType::UNIFORM:
+            return GL_UNIFORM_BUFFER;
+        case BlockType::STORAGE:
+            return GL_SHADER_STORAGE_BUFFER;
+        default:
+            GLOW_FAIL("Unknown block type.");
+            return GL_UNIFORM_BUFFER;
+        }
+    }
+
+    GLenum get_gl_uniform_type(const UniformValue& value) noexcept
+    {
+        return std::visit(overloaded {
+            [] (bool)         { return GLenum{GL_BOOL}; },
+            [] (int)          { return GLenum{GL_INT}; },
+            [] (uint)         { return GLenum{GL_UNSIGNED_INT}; },
+            [] (float)        { return GLenum{GL_FLOAT}; },
+            [] (const ivec2&) { return GLenum{GL_INT_VEC2}; },
+            [] (const uvec2&) { return GLenum{GL_UNSIGNED_INT_VEC2}; },
+            [] (const vec2&)  { return GLenum{GL_FLOAT_VEC2}; },
+            [] (const ivec3&) { return GLenum{GL_INT_VEC3}; },
+            [] (const uvec3&) { return GLenum{GL_UNSIGNED_INT_VEC3}; },
+            [] (const vec3&)  { return GLenum{GL_FLOAT_VEC3}; },
+            [] (const ivec4&) { return GLenum{GL_INT_VEC4}; },
+            [] (const uvec4&) { return GLenum{GL_UNSIGNED_INT_VEC4}; },
+            [] (const vec4&)  { return GLenum{GL_FLOAT_VEC4}; },
+            [] (const mat2&)  { return GLenum{GL_FLOAT_MAT2}; },
+            [] (const mat3&)  { return GLenum{GL_FLOAT_MAT3}; },
+            [] (const mat4&)  { return GLenum{GL_FLOAT_MAT4}; }
+        }, value);
+    }
+
+    UniformBuffer::UniformBuffer(Shader& shader, const std::string_view block, BlockType t)
+    : type(t)
+    {
+        auto program = shader.program_id;
+        GLOW_ASSERT(program != 0);
+
+        auto block_interface    = type == BlockType::UNIFORM ? GL_UNIFORM_BLOCK : GL_SHADER_STORAGE_BLOCK;
+        auto variable_interface = type == BlockType::UNIFORM ? GL_UNIFORM : GL_BUFFER_VARIABLE;
+
+        auto block_name = std::string{block};
+        auto index      = glGetProgramResourceIndex(program, block_interface, block_name.data());
+        if (index == GL_INVALID_INDEX)
+        {
+            throw std::runtime_error("Shader has no active block named '" + block_name + "'.");
+        }
+
+        const auto block_props = std::array<GLenum, 2>{GL_BUFFER_DATA_SIZE, GL_NUM_ACTIVE_VARIABLES};
+        auto block_values = std::array<GLint, 2>{};
+        glGetProgramResourceiv(program, block_interface, index,
+                               static_cast<GLsizei>(block_props.size()), block_props.data(),
+                               static_cast<GLsizei>(block_values.size()), nullptr, block_values.data());
+        auto [size, count] = block_values;
+
+        auto variables = std::vector<GLint>(static_cast<size_t>(count));
+        const auto variables_prop = GLenum{GL_ACTIVE_VARIABLES};
+        glGetProgramResourceiv(program, block_interface, index, 1, &variables_prop, count, nullptr, variables.data());
+
+        // only storage blocks report the stride of a top level array of structs,
+        // uniform blocks list the members of each element
+        const auto props = std::array<GLenum, 9>{GL_NAME_LENGTH, GL_TYPE, GL_OFFSET, GL_ARRAY_SIZE,
+                                                 GL_ARRAY_STRIDE, GL_MATRIX_STRIDE, GL_IS_ROW_MAJOR,
+                                                 GL_TOP_LEVEL_ARRAY_SIZE, GL_TOP_LEVEL_ARRAY_STRIDE};
+        auto prop_count = static_cast<GLsizei>(type == BlockType::STORAGE ? props.size() : props.size() - 2u);
+        for (auto variable : variables)
+        {
+            auto v = std::array<GLint, 9>{};
+            glGetProgramResourceiv(program, variable_interface, variable,
+                                   prop_count, props.data(),
+                                   static_cast<GLsizei>(v.size()), nullptr, v.data());
+
+            auto name = std::string(static_cast<size_t>(v[0]), '\0');
+            auto name_length = GLsizei{0};
+            glGetProgramResourceName(program, variable_interface, variable, v[0], &name_length, name.data());
+            name.resize(static_cast<size_t>(name_length));
+
+            // members of named blocks are prefixed with the block name
+            if (name.starts_with(block_name + "."))
+            {
+                name.erase(0, block_name.size() + 1);
+            }
+
+            auto member = Member{
+                static_cast<unsigned int>(v[1]),
+                static_cast<size_t>(v[2]),
+                static_cast<size_t>(v[3]),
+                static_cast<size_t>(v[4]),
+                static_cast<size_t>(v[5]),
+                v[6] != 0,
+                static_cast<size_t>(v[7]),
+                static_cast<size_t>(v[8])
+            };
+
+            // arrays are reported as "name[0]", but may be addressed as "name"
+            if (name.ends_with("[0]"))
+            {
+                members[name.substr(0, name.size() - 3)] = member;
+            }
+            members[std::move(name)] = member;
+        }
+
+        values.resize(static_cast<size_t>(size));
+
+        auto target = get_gl_target(type);
+        if (has_direct_state_access())
+        {
+            glCreateBuffers(1, &glid);
+            glNamedBufferStorage(glid, values.size(), values.data(), GL_DYNAMIC_STORAGE_BIT);
+        }
+        else
+        {
+            glGenBuffers(1, &glid);
+            glBindBuffer(target, glid);
+            glBufferData(target, values.size(), values.data(), GL_DYNAMIC_DRAW);
+            glBindBuffer(target, 0);
+        }
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    UniformBuffer::~UniformBuffer()
+    {
+        if (glid != 0)
+        {
+            glDeleteBuffers(1, &glid);
+            glid = 0;
+            GLOW_CHECK_GLERROR();
+        }
+    }
+
+    BlockType UniformBuffer::get_type() const noexcept
+    {
+        return type;
+    }
+
+    size_t UniformBuffer::get_size() const noexcept
+    {
+        return values.size();
+    }
+
+    bool UniformBuffer::has_member(const std::string_view name) const noexcept
+    {
+        auto offset = size_t{0};
+        return find_member(name, offset) != nullptr;
+    }
+
+    bool parse_index(const std::string_view text, size_t& index) noexcept
+    {
+        auto first = text.data();
+        auto last  = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(first, last, index);
+        return ec == std::errc{} && ptr == last;
+    }
+
+    const UniformBuffer::Member* UniformBuffer::find_member(const std::string_view name, size_t& offset) const noexcept
+    {
+        if (auto member = find_element(name, offset); member != nullptr)
+        {
+            return member;
+        }
+
+        // element of a top level array of structs "name[index].member",
+        // reported as "name[0].member" with the top level stride
+        auto open  = name.find('[');
+        auto close = name.find("].");
+        if (open == std::string_view::npos || close == std::string_view::npos || close < open)
+        {
+            return nullptr;
+        }
+
+        auto index = size_t{0};
+        if (!parse_index(name.substr(open + 1, close - open - 1), index) || index == 0u)
+        {
+            return nullptr;
+        }
+
+        auto first  = std::string{name.substr(0, open)} + "[0]" + std::string{name.substr(close + 1)};
+        auto member = find_element(first, offset);
+        if (member == nullptr || member->top_stride == 0u)
+        {
+            return nullptr;
+        }
+
+        // unsized arrays report a top level size of 0
+        if (member->top_size != 0u && index >= member->top_size)
+        {
+            return nullptr;
+        }
+
+        offset += index * member->top_stride;
+        if (offset >= values.size())
+        {
+            return nullptr;
+        }
+        return member;
+    }
+
+    const UniformBuffer::Member* UniformBuffer::find_element(const std::string_view name, size_t& offset) const noexcept
+    {
+        if (auto i = members.find(name); i != end(members))
+        {
+            offset = i->second.offset;
+            return &i->second;
+        }
+
+        // array element "name[index]"
+        auto open = name.rfind('[');
+        if (open == std::string_view::npos || !name.ends_with("]"))
+        {
+            return nullptr;
+        }
+
+        auto index = size_t{0};
+        if (!parse_index(name.substr(open + 1, name.size() - open - 2), index))
+        {
+            return nullptr;
+        }
+
+        auto i = members.find(name.substr(0, open));
+        if (i == end(members))
+        {
+            return nullptr;
+        }
+
+        // unsized arrays in storage blocks report an array size of 0
+        auto& member = i->second;
+        if (member.array_size != 0 && index >= member.array_size)
+        {
+            return nullptr;
+        }
+
+        offset = member.offset + index * member.array_stride;
+        if (offset >= values.size())
+        {
+            return nullptr;
+        }
+        return &member;
+    }
+
+    std::byte* UniformBuffer::modify(size_t offset, size_t size) noexcept
+    {
+        if (offset > values.size() || size > values.size() - offset)
+        {
+            return nullptr;
+        }
+
+        if (dirty_begin == dirty_end)
+        {
+            dirty_begin = offset;
+            dirty_end   = offset + size;
+        }
+        else
+        {
+            dirty_begin = std::min(dirty_begin, offset);
+            dirty_end   = std::max(dirty_end, offset + size);
+        }
+
+        return values.data() + offset;
+    }
+
+    template <int C, int R>
+    void write_matrix(std::byte* memory, size_t stride, bool row_major, const glm::mat<C, R, float>& value) noexcept
+    {
+        for (auto c = 0; c < C; c++)
+        {
+            for (auto r = 0; r < R; r++)
+            {
+                auto offset = row_major ? r * stride + c * sizeof(float) : c * stride + r * sizeof(float);
+                std::memcpy(memory + offset, &value[c][r], sizeof(float));
+            }
+        }
+    }
+
+    template <int C, int R>
+    constexpr size_t get_matrix_size(size_t stride, bool row_major) noexcept
+    {
+        return row_major ? (R - 1) * stride + C * sizeof(float) : (C - 1) * stride + R * sizeof(float);
+    }
+
+    void UniformBuffer::set(const std::string_view name, const UniformValue& value) noexcept
+    {
+        auto offset = size_t{0};
+        auto member = find_member(name, offset);
+        if (member == nullptr)
+        {
+            return;
+        }
+
+        if (member->type != get_gl_uniform_type(value))
+        {
+            GLOW_FAIL("UniformBuffer member type mismatch.");
+            return;
+        }
+
+        auto stride    = member->matrix_stride;
+        auto row_major = member->row_major;
+        auto size      = std::visit(overloaded {
+            // GLSL bool occupies 4 bytes
+            [&] (bool)        { return sizeof(GLint); },
+            [&] (const mat2&) { return get_matrix_size<2, 2>(stride, row_major); },
+            [&] (const mat3&) { return get_matrix_size<3, 3>(stride, row_major); },
+            [&] (const mat4&) { return get_matrix_size<4, 4>(stride, row_major); },
+            [&] (const auto& v) { return sizeof(v); }
+        }, value);
+
+        // unsized arrays may address elements past the end of the block
+        auto memory = modify(offset, size);
+        if (memory == nullptr)
+        {
+            return;
+        }
+
+        std::visit(overloaded {
+            [&] (bool v) {
+                auto i = GLint{v};
+                std::memcpy(memory, &i, sizeof(i));
+            },
+            [&] (const mat2& v) { write_matrix(memory, stride, row_major, v); },
+            [&] (const mat3& v) { write_matrix(memory, stride, row_major, v); },
+            [&] (const mat4& v) { write_matrix(memory, stride, row_major, v); },
+            [&] (const auto& v) { std::memcpy(memory, &v, sizeof(v)); }
+        }, value);
+    }
+
+    // bindless samplers are stored as 64 bit values
+    bool is_handle_type(GLenum type) noexcept
+    {
+        switch (type)
+        {
+        case GL_UNSIGNED_INT_VEC2:
+        case GL_UNSIGNED_INT64_ARB:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_SHADOW:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_SAMPLER_2D_ARRAY_SHADOW:
+        case GL_SAMPLER_CUBE_SHADOW:
+        case GL_SAMPLER_CUBE_MAP_ARRAY:
+        case GL_INT_SAMPLER_2D:
+        case GL_UNSIGNED_INT_SAMPLER_2D:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void UniformBuffer::set_handle(const std::string_view name, std::uint64_t handle) noexcept
+    {
+        auto offset = size_t{0};
+        auto member = find_member(name, offset);
+        if (member == nullptr)
+        {
+            return;
+        }
+
+        if (!is_handle_type(member->type))
+        {
+            GLOW_FAIL("UniformBuffer member type mismatch.");
+            return;
+        }
+
+        auto memory = modify(offset, sizeof(handle));
+        if (memory == nullptr)
+        {
+            return;
+        }
+        std::memcpy(memory, &handle, sizeof(handle));
+    }
+
+    void UniformBuffer::upload() noexcept
+    {
+        GLOW_DEBUG_GROUP("UniformBuffer::upload");
+        GLOW_ASSERT(glid != 0);
+
+        if (dirty_begin == dirty_end)
+        {
+            return;
+        }
+
+        if (has_direct_state_access())
+        {
+            glNamedBufferSubData(glid, dirty_begin, dirty_end - dirty_begin, values.data() + dirty_begin);
+        }
+        else
+        {
+            auto target = get_gl_target(type);
+            glBindBuffer(target, glid);
+            glBufferSubData(target, dirty_begin, dirty_end - dirty_begin, values.data() + dirty_begin);
+            glBindBuffer(target, 0);
+        }
+
+        dirty_begin = 0u;
+        dirty_end   = 0u;
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void UniformBuffer::bind(glm::uint binding) noexcept
+    {
+        GLOW_ASSERT(glid != 0);
+        glBindBufferBase(get_gl_target(type), binding, glid);
+        GLOW_CHECK_GLERROR();
+    }
+}
@@ -0,0 +1,145 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+#include "defines.h"
+#include "util.h"
+#include "Shader.h"
+
+namespace glow
+{
+    //! Interface Block Type
+    enum class BlockType
+    {
+        UNIFORM, //!< uniform block, usually std140 layout
+        STORAGE  //!< shader storage block, usually std430 layout
+    };
+
+    //! Uniform Buffer
+    //!
+    //! The uniform buffer holds the values of a named interface block.
+    //! The layout of the block is read from the linked shader, so values
+    //! are written at the offsets, array and matrix strides the layout
+    //! (std140, std430 or shared) dictates.
+    //!
+    //! Values are written into a CPU side copy of the block, only the
+    //! range modified since the last upload is sent to OpenGL.
+    //!
+    //! Since the layout is only read from one shader, the block must be
+    //! declared with an explicit layout (std140 or std430) if it is shared
+    //! across multiple shaders.
+    class GLOW_EXPORT UniformBuffer
+    {
+    public:
+        //! Create a buffer for an interface block.
+        //!
+        //! @param shader the compiled shader to read the layout from
+        //! @param block the name of the interface block
+        //! @param type the type of interface block
+        UniformBuffer(Shader& shader, const std::string_view block, BlockType type = BlockType::UNIFORM);
+
+        //! Release buffer.
+        ~UniformBuffer();
+
+        //! Get the interface block type.
+        BlockType get_type() const noexcept;
+
+        //! Get the size of the block in bytes.
+        size_t get_size() const noexcept;
+
+        //! Check if the block has a given member.
+        //!
+        //! @param name the member name, may contain an array index
+        bool has_member(const std::string_view name) const noexcept;
+
+        //! Set a block member value.
+        //!
+        //! Members of arrays may be addressed as "name[index]" and members
+        //! of arrays of structs as "name[index].member". The member name is
+        //! not prefixed with the block name.
+        //!
+        //! Unknown members, values of the wrong type and elements past the
+        //! end of the buffer are ignored. Elements of unsized arrays are
+        //! bounded by the block size reported by the shader, see get_size.
+        //!
+        //! @param name the member name
+        //! @param value the value to set
+        void set(const std::string_view name, const UniformValue& value) noexcept;
+
+        //! Set a bindless texture handle.
+        //!
+        //! The member may be a bindless sampler, a uvec2 or a uint64_t,
+        //! other members are ignored.
+        //!
+        //! @param name the member name
+        //! @param handle the handle obtained from TextureResidency::make_resident
+        void set_handle(const std::string_view name, std::uint64_t handle) noexcept;
+
+        //! Upload modified values.
+        //!
+        //! Only the range of values changed since the last upload is
+        //! transferred.
+        void upload() noexcept;
+
+        //! Bind buffer to a binding point.
+        //!
+        //! @param binding the binding index
+        //!
+        //! @see Shader::bind_uniform_block
+        //! @see Shader::bind_storage_block
+        void bind(glm::uint binding) noexcept;
+
+    private:
+        struct Member
+        {
+            unsigned int type          = 0u;
+            size_t       offset        = 0u;
+            size_t       array_size    = 0u;
+            size_t       array_stride  = 0u;
+            size_t       matrix_stride = 0u;
+            bool         row_major     = false;
+            size_t       top_size      = 0u;
+            size_t       top_stride    = 0u;
+        };
+
+        BlockType              type;
+        glm::uint              glid = 0u;
+        std::vector<std::byte> values;
+        size_t                 dirty_begin = 0u;
+        size_t                 dirty_end   = 0u;
+
+        std::unordered_map<std::string, Member, string_hash, std::equal_to<>> members;
+
+        const Member* find_member(const std::string_view name, size_t& offset) const noexcept;
+        const Member* find_element(const std::string_view name, size_t& offset) const noexcept;
+        std::byte* modify(size_t offset, size_t size) noexcept;
+
+        UniformBuffer(const UniformBuffer&) = delete;
+        UniformBuffer& operator = (const UniformBuffer&) = delete;
+    };
+}
@@ -21,30 +21,35 @@
 
 #include "pch.h"
 #include "VertexBuffer.h"
+#include "StateCache.h"
 #include "util.h"
 
 namespace glow
 {
     VertexBuffer::VertexBuffer() noexcept
     {
-        glGenVertexArrays(1, &vao);
+        if (has_direct_state_access())
+        {
+            glCreateVertexArrays(1, &vao);
+        }
+        else
+        {
+            glGenVertexArrays(1, &vao);
+        }
         GLOW_CHECK_GLERROR();
     }
 
     VertexBuffer::~VertexBuffer()
     {
-        for (auto& info: buffers)
+        for (auto& glid: buffers)
         {
-            if (info.glid != 0)
-            {
-                glDeleteBuffers(1, &info.glid);
-                info.glid = 0;
-            }
+            glDeleteBuffers(1, &glid);
+            glid = 0;
         }
 
         for (auto& info: indexes)
         {
-            if (info.glid != 0)
+            if (info.owned && info.glid != 0)
             {
                 glDeleteBuffers(1, &info.glid);
                 info.glid = 0;
@@ -52,6 +57,7 @@ namespace glow
         }
 
         glDeleteVertexArrays(1, &vao);
+        StateCache::get().release_vertex_array(vao);
         vao = 0;
 
         GLOW_CHECK_GLERROR();
@@ -59,56 +65,346 @@ namespace glow
 
     void VertexBuffer::bind(Shader& shader) noexcept
     {
-        glBindVertexArray(vao);
+        StateCache::get().bind_vertex_array(vao);
+
+        if (dirty || shader.get_attribute_interface() != bound_interface)
+        {
+            configure(shader);
+        }
 
-        for (auto& info: buffers)
+        GLOW_CHECK_GLERROR();
+    }
+
+    void VertexBuffer::configure(const Shader& shader) noexcept
+    {
+        // The standard attributes have fixed locations, so switching the
+        // shader rarely requires to respecify the attributes.
+        auto changed = dirty;
+        for (auto& info: attributes)
         {
-            info.adr = shader.get_attribute(info.attribute);
-            if (info.adr != -1)
+            auto adr = shader.get_attribute(info.attribute);
+            if (adr != info.adr)
+            {
+                info.adr = adr;
+                changed  = true;
+            }
+        }
+
+        bound_interface = shader.get_attribute_interface();
+        dirty           = false;
+
+        if (!changed)
+        {
+            return;
+        }
+
+        auto dsa = has_direct_state_access();
+
+        for (auto adr : enabled)
+        {
+            if (dsa)
+            {
+                glDisableVertexArrayAttrib(vao, adr);
+            }
+            else
+            {
+                glDisableVertexAttribArray(adr);
+            }
+        }
+        enabled.clear();
+
+        for (const auto& info: attributes)
+        {
+            if (info.adr == -1)
+            {
+                continue;
+            }
+
+            if (dsa)
+            {
+                configure_dsa(info);
+                continue;
+            }
+
+            glBindBuffer(GL_ARRAY_BUFFER, info.glid);
+
+            // matrices occupy one location per column
+            auto column_size = get_attribute_size(info.type, info.components);
+            for (auto c = 0u; c < info.columns; c++)
             {
-                glBindBuffer(GL_ARRAY_BUFFER, info.glid);
-                glVertexAttribPointer(info.adr, info.stride, GL_FLOAT, GL_FALSE, 0, 0);
-                glEnableVertexAttribArray(info.adr);
-                GLOW_CHECK_GLERROR();
+                auto adr = info.adr + c;
+                glVertexAttribPointer(adr, info.components, get_gl_attribute_type(info.type),
+                                      info.normalized ? GL_TRUE : GL_FALSE, info.stride,
+                                      reinterpret_cast<const void*>(info.offset + c * column_size));
+                glVertexAttribDivisor(adr, info.divisor);
+                glEnableVertexAttribArray(adr);
+                enabled.push_back(adr);
             }
         }
 
+        if (!dsa)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
         GLOW_CHECK_GLERROR();
     }
 
+    void VertexBuffer::configure_dsa(const AttributeInfo& info) noexcept
+    {
+        // each location gets its own buffer binding point
+        auto column_size = get_attribute_size(info.type, info.components);
+        auto stride      = info.stride != 0u ? info.stride : column_size;
+        for (auto c = 0u; c < info.columns; c++)
+        {
+            auto adr = static_cast<GLuint>(info.adr) + c;
+            glVertexArrayVertexBuffer(vao, adr, info.glid, static_cast<GLintptr>(info.offset + c * column_size), stride);
+            glVertexArrayAttribFormat(vao, adr, info.components, get_gl_attribute_type(info.type),
+                                      info.normalized ? GL_TRUE : GL_FALSE, 0u);
+            glVertexArrayAttribBinding(vao, adr, adr);
+            glVertexArrayBindingDivisor(vao, adr, info.divisor);
+            glEnableVertexArrayAttrib(vao, adr);
+            enabled.push_back(adr);
+        }
+    }
+
     void VertexBuffer::unbind() noexcept
     {
-        glBindVertexArray(0);
+        StateCache::get().bind_vertex_array(0);
         GLOW_CHECK_GLERROR();
     }
 
+    unsigned int VertexBuffer::create_buffer(unsigned int target, size_t size, const void* data) noexcept
+    {
+        // glNamedBufferStorage rejects empty buffers
+        GLOW_ASSERT(size > 0u);
+
+        auto glid = 0u;
+        if (has_direct_state_access())
+        {
+            // the buffers are never written again
+            glCreateBuffers(1, &glid);
+            glNamedBufferStorage(glid, size, data, 0);
+        }
+        else
+        {
+            glGenBuffers(1, &glid);
+            glBindBuffer(target, glid);
+            glBufferData(target, size, data, GL_STATIC_DRAW);
+            glBindBuffer(target, 0);
+        }
+        GLOW_CHECK_GLERROR();
+
+        buffers.push_back(glid);
+        return glid;
+    }
+
+    void VertexBuffer::release_buffer(unsigned int glid) noexcept
+    {
+        auto used = std::any_of(begin(attributes), end(attributes), [&] (const auto& info) {
+            return info.glid == glid;
+        });
+        if (used)
+        {
+            return;
+        }
+
+        // buffers of stream buffers are not owned
+        if (auto i = std::find(begin(buffers), end(buffers), glid); i != end(buffers))
+        {
+            glDeleteBuffers(1, &glid);
+            buffers.erase(i);
+            GLOW_CHECK_GLERROR();
+        }
+    }
+
+    void VertexBuffer::set_attribute(const AttributeInfo& info) noexcept
+    {
+        auto i = std::find_if(begin(attributes), end(attributes), [&] (const auto& a) {
+            return a.attribute == info.attribute;
+        });
+
+        dirty = true;
+
+        if (i == end(attributes))
+        {
+            attributes.push_back(info);
+            return;
+        }
+
+        auto old = i->glid;
+        *i = info;
+        if (old != info.glid)
+        {
+            release_buffer(old);
+        }
+    }
+
     void VertexBuffer::upload_values(const std::string& attribute, unsigned int stride, unsigned int count, const float* data) noexcept
     {
-        unsigned int glid;
-        glGenBuffers(1, &glid);
-        glBindBuffer(GL_ARRAY_BUFFER, glid);
-        glBufferData(GL_ARRAY_BUFFER, count * stride * sizeof(float), data, GL_STATIC_DRAW);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GLOW_DEBUG_GROUP("VertexBuffer::upload_values");
+        auto glid = create_buffer(GL_ARRAY_BUFFER, count * stride * sizeof(float), data);
+        set_attribute({attribute, stride, AttributeType::FLOAT, false, 0u, 0u, count, glid});
+    }
 
-        buffers.push_back({attribute, stride, count, glid, 0});
+    void VertexBuffer::upload_instance_values(const std::string& attribute, unsigned int stride, unsigned int count, const float* data, unsigned int divisor) noexcept
+    {
+        GLOW_DEBUG_GROUP("VertexBuffer::upload_instance_values");
+        GLOW_ASSERT(divisor > 0u);
 
-        GLOW_CHECK_GLERROR();
+        auto glid = create_buffer(GL_ARRAY_BUFFER, count * stride * sizeof(float), data);
+        set_attribute({attribute, stride, AttributeType::FLOAT, false, 0u, 0u, count, glid, divisor});
+    }
+
+    void VertexBuffer::upload_instance_values(const std::string& attribute, const std::vector<glm::mat4>& values, unsigned int divisor) noexcept
+    {
+        GLOW_DEBUG_GROUP("VertexBuffer::upload_instance_values");
+        GLOW_ASSERT(divisor > 0u);
+
+        auto count = static_cast<unsigned int>(values.size());
+        auto glid  = create_buffer(GL_ARRAY_BUFFER, values.size() * sizeof(glm::mat4), glm::value_ptr(values[0]));
+        set_attribute({attribute, 4u, AttributeType::FLOAT, false, sizeof(glm::mat4), 0u, count, glid, divisor, 4u});
+    }
+
+    void VertexBuffer::upload_interleaved(const VertexLayout& layout, unsigned int count, const void* data, unsigned int divisor) noexcept
+    {
+        GLOW_DEBUG_GROUP("VertexBuffer::upload_interleaved");
+        GLOW_ASSERT(layout.get_stride() > 0u);
+
+        auto stride = layout.get_stride();
+        auto glid   = create_buffer(GL_ARRAY_BUFFER, static_cast<size_t>(count) * stride, data);
+        for (const auto& attribute : layout.get_attributes())
+        {
+            set_attribute({attribute.name, attribute.components, attribute.type, attribute.normalized, stride, attribute.offset, count, glid, divisor});
+        }
+    }
+
+    void VertexBuffer::stream_values(const std::string& attribute, unsigned int stride, const StreamBuffer& buffer, const StreamRange& range, unsigned int divisor) noexcept
+    {
+        GLOW_ASSERT(range.is_valid());
+        GLOW_ASSERT(stride > 0u);
+
+        auto count = static_cast<unsigned int>(range.size / (stride * sizeof(float)));
+        set_attribute({attribute, stride, AttributeType::FLOAT, false, 0u, range.offset, count, buffer.glid, divisor});
+    }
+
+    unsigned int get_index_size(IndexType type) noexcept
+    {
+        switch (type)
+        {
+        case IndexType::UINT8:
+            return 1u;
+        case IndexType::UINT16:
+            return 2u;
+        case IndexType::UINT32:
+            return 4u;
+        default:
+            GLOW_FAIL("Unknown index type.");
+            return 4u;
+        }
+    }
+
+    constexpr GLenum get_gl_index_type(IndexType type) noexcept
+    {
+        switch (type)
+        {
+        case IndexType::UINT8:
+            return GL_UNSIGNED_BYTE;
+        case IndexType::UINT16:
+            return GL_UNSIGNED_SHORT;
+        case IndexType::UINT32:
+            return GL_UNSIGNED_INT;
+        default:
+            GLOW_FAIL("Unknown index type.");
+            return GL_UNSIGNED_INT;
+        }
     }
 
-    void VertexBuffer::upload_indexes(FacesType type, unsigned int count, const unsigned int* data) noexcept
+    void VertexBuffer::add_indexes(FacesType type, unsigned int count, IndexType index_type, const void* data) noexcept
     {
         auto glid = 0u;
-        glGenBuffers(1, &glid);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glid);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        auto size = count * get_index_size(index_type);
+        GLOW_ASSERT(size > 0u);
+
+        if (has_direct_state_access())
+        {
+            glCreateBuffers(1, &glid);
+            glNamedBufferStorage(glid, size, data, 0);
+        }
+        else
+        {
+            // the element buffer binding is part of the bound vertex array state
+            glGenBuffers(1, &glid);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, glid);
+            glBufferData(GL_COPY_WRITE_BUFFER, size, data, GL_STATIC_DRAW);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+
+        indexes.push_back({type, count, glid, 0u, true, index_type});
+
+        GLOW_CHECK_GLERROR();
+    }
 
-        indexes.push_back({type, count, glid});
+    void VertexBuffer::upload_indexes(FacesType type, unsigned int count, const unsigned int* data, bool narrow) noexcept
+    {
+        GLOW_DEBUG_GROUP("VertexBuffer::upload_indexes");
+        if (narrow && count > 0u && *std::max_element(data, data + count) <= 0xFFFFu)
+        {
+            auto narrowed = std::vector<std::uint16_t>(count);
+            std::transform(data, data + count, begin(narrowed), [] (auto i) {
+                return static_cast<std::uint16_t>(i);
+            });
+            add_indexes(type, count, IndexType::UINT16, narrowed.data());
+        }
+        else
+        {
+            add_indexes(type, count, IndexType::UINT32, data);
+        }
+    }
+
+    void VertexBuffer::upload_indexes(FacesType type, unsigned int count, const std::uint16_t* data) noexcept
+    {
+        GLOW_DEBUG_GROUP("VertexBuffer::upload_indexes");
+        add_indexes(type, count, IndexType::UINT16, data);
+    }
+
+    void VertexBuffer::upload_indexes(FacesType type, unsigned int count, const std::uint8_t* data) noexcept
+    {
+        GLOW_DEBUG_GROUP("VertexBuffer::upload_indexes");
+        add_indexes(type, count, IndexType::UINT8, data);
+    }
+
+    void VertexBuffer::stream_indexes(FacesType type, unsigned int count, const StreamBuffer& buffer, const StreamRange& range, unsigned int set, IndexType index_type) noexcept
+    {
+        GLOW_ASSERT(range.is_valid());
+        GLOW_ASSERT(count * get_index_size(index_type) <= range.size);
+        GLOW_ASSERT(set <= indexes.size());
+
+        if (set == indexes.size())
+        {
+            indexes.push_back({type, count, 0u});
+        }
+
+        auto& info = indexes[set];
+        if (info.owned && info.glid != 0)
+        {
+            glDeleteBuffers(1, &info.glid);
+        }
+        if (info.glid == bound_indexes)
+        {
+            bound_indexes = 0u;
+        }
+
+        info.type       = type;
+        info.count      = count;
+        info.glid       = buffer.glid;
+        info.offset     = range.offset;
+        info.owned      = false;
+        info.index_type = index_type;
 
         GLOW_CHECK_GLERROR();
     }
 
-    constexpr GLenum get_gl_facetype(FacesType type)
+    unsigned int get_gl_facetype(FacesType type) noexcept
     {
         switch (type)
         {
@@ -132,16 +428,41 @@ namespace glow
         }
     }
 
+    void VertexBuffer::bind_indexes(unsigned int glid) noexcept
+    {
+        // the vertex array keeps the element buffer binding between draws
+        if (glid != bound_indexes)
+        {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glid);
+            bound_indexes = glid;
+        }
+    }
+
     void VertexBuffer::draw(unsigned int set) noexcept
     {
+        GLOW_DEBUG_GROUP("VertexBuffer::draw");
+        GLOW_ASSERT(set < indexes.size());
+
+        auto iinfo    = indexes[set];
+        auto gl_shape = get_gl_facetype(iinfo.type);
+
+        bind_indexes(iinfo.glid);
+        glDrawElements(gl_shape, iinfo.count, get_gl_index_type(iinfo.index_type), reinterpret_cast<const void*>(iinfo.offset));
+
+        GLOW_CHECK_GLERROR();
+    }
+
+    void VertexBuffer::draw_instanced(unsigned int set, unsigned int instance_count, unsigned int base_instance) noexcept
+    {
+        GLOW_DEBUG_GROUP("VertexBuffer::draw_instanced");
         GLOW_ASSERT(set < indexes.size());
 
         auto iinfo    = indexes[set];
         auto gl_shape = get_gl_facetype(iinfo.type);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, iinfo.glid);
-        glDrawElements(gl_shape, iinfo.count, GL_UNSIGNED_INT, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        bind_indexes(iinfo.glid);
+        glDrawElementsInstancedBaseInstance(gl_shape, iinfo.count, get_gl_index_type(iinfo.index_type), reinterpret_cast<const void*>(iinfo.offset),
+                                            instance_count, base_instance);
 
         GLOW_CHECK_GLERROR();
     }
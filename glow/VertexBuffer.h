@@ -23,6 +23,7 @@
 
 #include "defines.h"
 
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -31,14 +32,11 @@
 
 #include "util.h"
 #include "Shader.h"
+#include "StreamBuffer.h"
+#include "VertexLayout.h"
 
 namespace glow
 {
-    constexpr auto VERTEX   = "glow_Vertex";
-    constexpr auto NORMAL   = "glow_Normal";
-    constexpr auto TANGENT  = "glow_Tangent";
-    constexpr auto TEXCOORD = "glow_TexCoord";
-
     //! Face Type
     enum class FacesType
     {
@@ -51,6 +49,20 @@ namespace glow
         TRIANGLE_FAN
     };
 
+    //! Index Type
+    enum class IndexType
+    {
+        UINT8,
+        UINT16,
+        UINT32
+    };
+
+    //! Get the size of an index in bytes.
+    GLOW_EXPORT unsigned int get_index_size(IndexType type) noexcept;
+
+    //! Get the OpenGL primitive enum of a faces type.
+    GLOW_EXPORT unsigned int get_gl_facetype(FacesType type) noexcept;
+
     //! Vertex Buffer
     class GLOW_EXPORT VertexBuffer
     {
@@ -63,6 +75,10 @@ namespace glow
 
         //!Bind vertex buffer to shader.
         //!
+        //! The vertex array is only reconfigured, if the shader's
+        //! attribute locations differ from the last shader or the
+        //! attributes changed. Otherwise this only binds the vertex array.
+        //!
         //!@param shader to bind to
         void bind(Shader& shader) noexcept;
 
@@ -70,30 +86,126 @@ namespace glow
         void unbind() noexcept;
 
         //! Upload vertex values.
+        //!
+        //! Uploading values for an attribute that already has values
+        //! replaces them.
         void upload_values(const std::string& attribute, unsigned int stride, unsigned int count, const float* data) noexcept;
 
         //! Upload vertex values.
         template <int N, glm::qualifier Q>
         void upload_values(const std::string& attribute, const std::vector<glm::vec<N, float, Q>>& values) noexcept;
 
+        //! Upload per instance values.
+        //!
+        //! The values advance once every divisor instances instead of
+        //! once per vertex.
+        //!
+        //! @param attribute the attribute name
+        //! @param stride the number of floats per instance
+        //! @param count the number of instances
+        //! @param data the values
+        //! @param divisor the number of instances that share a value
+        //!
+        //! @see draw_instanced
+        void upload_instance_values(const std::string& attribute, unsigned int stride, unsigned int count, const float* data, unsigned int divisor = 1u) noexcept;
+
+        //! Upload per instance values.
+        template <int N, glm::qualifier Q>
+        void upload_instance_values(const std::string& attribute, const std::vector<glm::vec<N, float, Q>>& values, unsigned int divisor = 1u) noexcept;
+
+        //! Upload per instance matrices.
+        //!
+        //! A mat4 attribute occupies four consecutive attribute locations,
+        //! one per column.
+        //!
+        //! @param attribute the attribute name
+        //! @param values the matrices
+        //! @param divisor the number of instances that share a value
+        void upload_instance_values(const std::string& attribute, const std::vector<glm::mat4>& values, unsigned int divisor = 1u) noexcept;
+
+        //! Upload interleaved vertex values.
+        //!
+        //! All attributes of the layout are stored in one buffer. Replaces
+        //! any values of the attributes.
+        //!
+        //! @param layout the layout of one vertex
+        //! @param count the number of vertices
+        //! @param data the vertex data, count times the layout stride in bytes
+        //! @param divisor 0 for per vertex values, otherwise the number of instances that share a value
+        void upload_interleaved(const VertexLayout& layout, unsigned int count, const void* data, unsigned int divisor = 0u) noexcept;
+
+        //! Use vertex values from a stream buffer.
+        //!
+        //! The values are not copied, the range must remain valid until
+        //! the vertex buffer is drawn. Replaces any values of the attribute.
+        //!
+        //! @param attribute the attribute name
+        //! @param stride the number of floats per vertex
+        //! @param buffer the stream buffer holding the values
+        //! @param range the range within the stream buffer
+        //! @param divisor 0 for per vertex values, otherwise the number of instances that share a value
+        void stream_values(const std::string& attribute, unsigned int stride, const StreamBuffer& buffer, const StreamRange& range, unsigned int divisor = 0u) noexcept;
+
         //! Upload face indexes.
-        void upload_indexes(FacesType type, unsigned int count, const unsigned int* data) noexcept;
+        //!
+        //! If narrow is set and all indexes fit into 16 bits, the indexes
+        //! are stored as 16 bit indexes, halving the memory and bandwidth
+        //! used. Indexes are never narrowed to 8 bits, since some hardware
+        //! does not support them natively.
+        //!
+        //! @param type the faces type
+        //! @param count the number of indexes
+        //! @param data the indexes
+        //! @param narrow store the indexes with 16 bits if possible
+        void upload_indexes(FacesType type, unsigned int count, const unsigned int* data, bool narrow = true) noexcept;
+
+        //! Upload 16 bit face indexes.
+        void upload_indexes(FacesType type, unsigned int count, const std::uint16_t* data) noexcept;
+
+        //! Upload 8 bit face indexes.
+        void upload_indexes(FacesType type, unsigned int count, const std::uint8_t* data) noexcept;
 
         //! Upload face indexes.
-        template <int N, glm::qualifier Q>
-        void upload_indexes(const std::vector<glm::vec<N, glm::uint, Q>>& indexes) noexcept;
+        template <int N, typename T, glm::qualifier Q>
+        void upload_indexes(const std::vector<glm::vec<N, T, Q>>& indexes) noexcept;
+
+        //! Use face indexes from a stream buffer.
+        //!
+        //! The indexes are not copied, the range must remain valid until
+        //! the vertex buffer is drawn.
+        //!
+        //! @param type the faces type
+        //! @param count the number of indexes
+        //! @param buffer the stream buffer holding the indexes
+        //! @param range the range within the stream buffer
+        //! @param set the index set to replace, or the number of sets to add one
+        //! @param index_type the type of the indexes
+        void stream_indexes(FacesType type, unsigned int count, const StreamBuffer& buffer, const StreamRange& range, unsigned int set = 0, IndexType index_type = IndexType::UINT32) noexcept;
 
         //! Draw vertex buffer.
         void draw(unsigned int set = 0) noexcept;
 
+        //! Draw multiple instances of the vertex buffer in one call.
+        //!
+        //! @param set the index set to draw
+        //! @param instance_count the number of instances to draw
+        //! @param base_instance the first instance of the per instance values
+        void draw_instanced(unsigned int set, unsigned int instance_count, unsigned int base_instance = 0u) noexcept;
+
     private:
-        struct BufferInfo
+        struct AttributeInfo
         {
-            std::string  attribute;
-            unsigned int stride;
-            unsigned int count;
-            unsigned int glid;
-            unsigned int adr;
+            std::string   attribute;
+            unsigned int  components;
+            AttributeType type;
+            bool          normalized;
+            unsigned int  stride;
+            size_t        offset;
+            unsigned int  count;
+            unsigned int  glid;
+            unsigned int  divisor = 0u;
+            unsigned int  columns = 1u;
+            int           adr     = -1;
         };
 
         struct IndexInfo
@@ -101,11 +213,27 @@ namespace glow
             FacesType     type;
             unsigned int  count;
             unsigned int  glid;
+            size_t        offset     = 0u;
+            bool          owned      = true;
+            IndexType     index_type = IndexType::UINT32;
         };
 
-        unsigned int            vao = 0;
-        std::vector<BufferInfo> buffers;
-        std::vector<IndexInfo>  indexes;
+        unsigned int               vao = 0;
+        std::vector<AttributeInfo> attributes;
+        std::vector<unsigned int>  buffers;
+        std::vector<IndexInfo>     indexes;
+        std::vector<unsigned int>  enabled;
+        size_t                     bound_interface = 0u;
+        bool                       dirty           = true;
+        unsigned int               bound_indexes   = 0u;
+
+        unsigned int create_buffer(unsigned int target, size_t size, const void* data) noexcept;
+        void release_buffer(unsigned int glid) noexcept;
+        void set_attribute(const AttributeInfo& info) noexcept;
+        void add_indexes(FacesType type, unsigned int count, IndexType index_type, const void* data) noexcept;
+        void configure(const Shader& shader) noexcept;
+        void configure_dsa(const AttributeInfo& info) noexcept;
+        void bind_indexes(unsigned int glid) noexcept;
 
         VertexBuffer(const VertexBuffer&) = delete;
         VertexBuffer& operator = (const VertexBuffer&) = delete;
@@ -117,6 +245,12 @@ namespace glow
         upload_values(attribute, N, static_cast<uint>(values.size()), glm::value_ptr(values[0]));
     }
 
+    template <int N, glm::qualifier Q>
+    void VertexBuffer::upload_instance_values(const std::string& attribute, const std::vector<glm::vec<N, float, Q>>& values, unsigned int divisor) noexcept
+    {
+        upload_instance_values(attribute, N, static_cast<uint>(values.size()), glm::value_ptr(values[0]), divisor);
+    }
+
     constexpr FacesType get_face_type(uint N) noexcept
     {
         switch (N)
@@ -136,8 +270,8 @@ namespace glow
         }
     }
 
-    template <int N, glm::qualifier Q>
-    void VertexBuffer::upload_indexes(const std::vector<glm::vec<N, glm::uint, Q>>& indexes) noexcept
+    template <int N, typename T, glm::qualifier Q>
+    void VertexBuffer::upload_indexes(const std::vector<glm::vec<N, T, Q>>& indexes) noexcept
     {
         auto type = get_face_type(N);
         upload_indexes(type, static_cast<uint>(indexes.size()) * N, glm::value_ptr(indexes[0]));
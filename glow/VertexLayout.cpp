@@ -0,0 +1,126 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "pch.h"
+#include "VertexLayout.h"
+#include "util.h"
+
+namespace glow
+{
+    unsigned int get_attribute_size(AttributeType type, unsigned int components) noexcept
+    {
+        switch (type)
+        {
+        case AttributeType::INT8:
+        case AttributeType::UINT8:
+            return components;
+        case AttributeType::HALF:
+        case AttributeType::INT16:
+        case AttributeType::UINT16:
+            return components * 2u;
+        case AttributeType::FLOAT:
+        case AttributeType::INT32:
+        case AttributeType::UINT32:
+            return components * 4u;
+        case AttributeType::INT_10_10_10_2:
+        case AttributeType::UINT_10_10_10_2:
+            GLOW_ASSERT(components == 4u);
+            return 4u;
+        default:
+            GLOW_FAIL("Unknown attribute type.");
+            return components * 4u;
+        }
+    }
+
+    unsigned int get_gl_attribute_type(AttributeType type) noexcept
+    {
+        switch (type)
+        {
+        case AttributeType::FLOAT:
+            return GL_FLOAT;
+        case AttributeType::HALF:
+            return GL_HALF_FLOAT;
+        case AttributeType::INT8:
+            return GL_BYTE;
+        case AttributeType::UINT8:
+            return GL_UNSIGNED_BYTE;
+        case AttributeType::INT16:
+            return GL_SHORT;
+        case AttributeType::UINT16:
+            return GL_UNSIGNED_SHORT;
+        case AttributeType::INT32:
+            return GL_INT;
+        case AttributeType::UINT32:
+            return GL_UNSIGNED_INT;
+        case AttributeType::INT_10_10_10_2:
+            return GL_INT_2_10_10_10_REV;
+        case AttributeType::UINT_10_10_10_2:
+            return GL_UNSIGNED_INT_2_10_10_10_REV;
+        default:
+            GLOW_FAIL("Unknown attribute type.");
+            return GL_FLOAT;
+        }
+    }
+
+    constexpr unsigned int align4(unsigned int value) noexcept
+    {
+        return (value + 3u) & ~3u;
+    }
+
+    VertexLayout& VertexLayout::add(const std::string& name, unsigned int components, AttributeType type, bool normalized) noexcept
+    {
+        auto offset = 0u;
+        if (!attributes.empty())
+        {
+            const auto& last = attributes.back();
+            offset = align4(last.offset + get_attribute_size(last.type, last.components));
+        }
+
+        return add({name, components, type, normalized, offset});
+    }
+
+    VertexLayout& VertexLayout::add(const VertexAttribute& attribute) noexcept
+    {
+        GLOW_ASSERT(attribute.components >= 1u && attribute.components <= 4u);
+
+        attributes.push_back(attribute);
+
+        auto end = align4(attribute.offset + get_attribute_size(attribute.type, attribute.components));
+        stride = std::max(stride, end);
+
+        return *this;
+    }
+
+    const std::vector<VertexAttribute>& VertexLayout::get_attributes() const noexcept
+    {
+        return attributes;
+    }
+
+    void VertexLayout::set_stride(unsigned int value) noexcept
+    {
+        stride = value;
+    }
+
+    unsigned int VertexLayout::get_stride() const noexcept
+    {
+        return stride;
+    }
+}
@@ -0,0 +1,116 @@
+// OpenGL Object Wrapper
+// Copyright 2016-2026 Sean Farrell <sean.farrell@rioki.org>
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "defines.h"
+
+namespace glow
+{
+    //! Vertex Attribute Type
+    enum class AttributeType
+    {
+        FLOAT,
+        HALF,
+        INT8,
+        UINT8,
+        INT16,
+        UINT16,
+        INT32,
+        UINT32,
+        INT_10_10_10_2,  //!< 4 components packed into 32 bits, GL_INT_2_10_10_10_REV
+        UINT_10_10_10_2  //!< 4 components packed into 32 bits, GL_UNSIGNED_INT_2_10_10_10_REV
+    };
+
+    //! Vertex Attribute Format
+    struct VertexAttribute
+    {
+        //! The attribute name.
+        std::string   name;
+        //! The number of components, 1 to 4.
+        unsigned int  components = 4u;
+        //! The component type.
+        AttributeType type       = AttributeType::FLOAT;
+        //! Map integer values to [0, 1] or [-1, 1].
+        bool          normalized = false;
+        //! The offset in bytes from the start of the vertex.
+        unsigned int  offset     = 0u;
+    };
+
+    //! Get the size in bytes of an attribute.
+    GLOW_EXPORT unsigned int get_attribute_size(AttributeType type, unsigned int components) noexcept;
+
+    //! Get the OpenGL type enum of an attribute type.
+    GLOW_EXPORT unsigned int get_gl_attribute_type(AttributeType type) noexcept;
+
+    //! Vertex Layout
+    //!
+    //! The vertex layout describes the attributes of interleaved vertex
+    //! data. Compact formats, such as half floats for texture coordinates,
+    //! normalized 16 bit integers for positions or packed 10 bit normals,
+    //! can substantially reduce the vertex size. The glm/gtc/packing.hpp
+    //! functions produce values in these formats.
+    //!
+    //! @see VertexBuffer::upload_interleaved
+    class GLOW_EXPORT VertexLayout
+    {
+    public:
+        //! Create an empty layout.
+        VertexLayout() noexcept = default;
+
+        //! Add an attribute after the previous attribute.
+        //!
+        //! The attribute is aligned to 4 bytes.
+        //!
+        //! @param name the attribute name
+        //! @param components the number of components
+        //! @param type the component type
+        //! @param normalized map integer values to [0, 1] or [-1, 1]
+        //! @return the layout, for chaining
+        VertexLayout& add(const std::string& name, unsigned int components, AttributeType type = AttributeType::FLOAT, bool normalized = false) noexcept;
+
+        //! Add an attribute at an explicit offset.
+        //!
+        //! @param attribute the attribute format
+        //! @return the layout, for chaining
+        VertexLayout& add(const VertexAttribute& attribute) noexcept;
+
+        //! Get the attributes.
+        const std::vector<VertexAttribute>& get_attributes() const noexcept;
+
+        //! Vertex Stride
+        //!
+        //! The size in bytes of one vertex. The stride grows as attributes
+        //! are added, but may be set larger to add padding.
+        //!
+        //! @{
+        void set_stride(unsigned int value) noexcept;
+        unsigned int get_stride() const noexcept;
+        //! @}
+
+    private:
+        std::vector<VertexAttribute> attributes;
+        unsigned int                 stride = 0u;
+    };
+}
@@ -26,5 +26,26 @@ namespace glow
     class Shader;
     class Texture;
     class VertexBuffer;
+    class VertexLayout;
+    class MeshPool;
+    class DrawBatch;
 	class FrameBuffer;
+    class UniformBuffer;
+    class ProgramCache;
+    class ShaderCompiler;
+    class StreamBuffer;
+    class TextureUploader;
+    class TextureFile;
+    class MipChain;
+    class TextureResidency;
+    class Sampler;
+    class PixelReader;
+    class GpuProfiler;
+    class GpuScope;
+    struct ProfileNode;
+    struct ProfileFrame;
+    class StateCache;
+    struct DrawPacket;
+    class CommandRecorder;
+    class CommandQueue;
 }
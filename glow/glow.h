@@ -24,8 +24,23 @@
 #include "defines.h"
 
 #include "util.h"
+#include "StateCache.h"
+#include "CommandQueue.h"
 #include "Shader.h"
+#include "ProgramCache.h"
+#include "ShaderCompiler.h"
+#include "VertexLayout.h"
 #include "VertexBuffer.h"
+#include "MeshPool.h"
+#include "DrawBatch.h"
 #include "Texture.h"
+#include "TextureUploader.h"
+#include "TextureFile.h"
+#include "MipChain.h"
+#include "TextureResidency.h"
+#include "Sampler.h"
+#include "PixelReader.h"
 #include "FrameBuffer.h"
-#include "Pipeline.h"
+#include "UniformBuffer.h"
+#include "StreamBuffer.h"
+#include "GpuProfiler.h"
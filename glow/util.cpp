@@ -63,7 +63,149 @@ namespace glow
         }
     }
 
-    void init()
+    bool debug_supported = false;
+    bool debug_output    = false;
+    bool dsa_supported   = false;
+    thread_local const DebugGroup* current_group = nullptr;
+
+    void write_output(const std::string& output) noexcept
+    {
+        #ifdef _WIN32
+        OutputDebugStringA(output.data());
+        #else
+        std::cerr << output;
+        #endif
+    }
+
+    const char* debug_source_to_string(GLenum source) noexcept
+    {
+        switch (source)
+        {
+        case GL_DEBUG_SOURCE_API:
+            return "API";
+        case GL_DEBUG_SOURCE_WINDOW_SYSTEM:
+            return "window system";
+        case GL_DEBUG_SOURCE_SHADER_COMPILER:
+            return "shader compiler";
+        case GL_DEBUG_SOURCE_THIRD_PARTY:
+            return "third party";
+        case GL_DEBUG_SOURCE_APPLICATION:
+            return "application";
+        default:
+            return "other";
+        }
+    }
+
+    const char* debug_type_to_string(GLenum type) noexcept
+    {
+        switch (type)
+        {
+        case GL_DEBUG_TYPE_ERROR:
+            return "error";
+        case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR:
+            return "deprecated behavior";
+        case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:
+            return "undefined behavior";
+        case GL_DEBUG_TYPE_PORTABILITY:
+            return "portability";
+        case GL_DEBUG_TYPE_PERFORMANCE:
+            return "performance";
+        case GL_DEBUG_TYPE_MARKER:
+            return "marker";
+        default:
+            return "other";
+        }
+    }
+
+    GLenum glseverity(DebugSeverity severity) noexcept
+    {
+        switch (severity)
+        {
+        case DebugSeverity::NOTIFICATION:
+            return GL_DEBUG_SEVERITY_NOTIFICATION;
+        case DebugSeverity::LOW:
+            return GL_DEBUG_SEVERITY_LOW;
+        case DebugSeverity::MEDIUM:
+            return GL_DEBUG_SEVERITY_MEDIUM;
+        case DebugSeverity::HIGH:
+            return GL_DEBUG_SEVERITY_HIGH;
+        default:
+            GLOW_FAIL("Unknown DebugSeverity");
+            return GL_DEBUG_SEVERITY_HIGH;
+        }
+    }
+
+#if !defined(NDEBUG) && defined(__cpp_lib_format) && !defined(_WIN_UWP_) && defined(_WIN32)
+    void show_message_box(const std::string_view& message) noexcept;
+#endif
+
+    void GLAPIENTRY handle_debug_message(GLenum source, GLenum type, GLuint id, [[maybe_unused]] GLenum severity, GLsizei length, const GLchar* message, [[maybe_unused]] const void* user) noexcept
+    {
+        auto file  = std::string{"OpenGL"};
+        auto line  = 0u;
+        auto group = std::string{};
+        if (current_group != nullptr)
+        {
+            file  = current_group->get_file();
+            line  = current_group->get_line();
+            group = std::string(" in ") + current_group->get_name();
+            auto i = file.find_last_of("\\/");
+            if (i != std::string::npos)
+            {
+                file = file.substr(i + 1);
+            }
+        }
+
+        auto msg = std::string(debug_source_to_string(source)) + " " + debug_type_to_string(type) + " " + std::to_string(id) + group + ": " + std::string(message, length);
+        write_output(file + "(" + std::to_string(line) + "): " + msg + "\n");
+
+        #if !defined(NDEBUG) && defined(__cpp_lib_format) && !defined(_WIN_UWP_)
+        if (type == GL_DEBUG_TYPE_ERROR)
+        {
+            #ifdef _WIN32
+            show_message_box(msg);
+            #else
+            std::terminate();
+            #endif
+        }
+        #endif
+    }
+
+    void enable_debug_output(const DebugOptions& options) noexcept
+    {
+        if (!debug_supported)
+        {
+            return;
+        }
+
+        glEnable(GL_DEBUG_OUTPUT);
+        if (options.synchronous)
+        {
+            glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+        }
+        else
+        {
+            glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+        }
+        glDebugMessageCallback(handle_debug_message, nullptr);
+
+        // let the driver drop the messages below the severity
+        glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+        for (auto severity : {DebugSeverity::NOTIFICATION, DebugSeverity::LOW, DebugSeverity::MEDIUM})
+        {
+            if (severity < options.severity)
+            {
+                glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, glseverity(severity), 0, nullptr, GL_FALSE);
+            }
+        }
+        glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_ERROR, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+        glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_PUSH_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+        glDebugMessageControl(GL_DONT_CARE, GL_DEBUG_TYPE_POP_GROUP, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+
+        debug_output = true;
+    }
+
+    void init(const DebugOptions& debug)
     {
         static auto is_init  = false;
         if (is_init == false)
@@ -76,8 +218,65 @@ namespace glow
             }
 
             clear_errors();
+            debug_supported = GLEW_VERSION_4_3 || GLEW_KHR_debug;
+            dsa_supported   = GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
             is_init = true;
         }
+
+        if (debug.enabled)
+        {
+            enable_debug_output(debug);
+        }
+    }
+
+    bool is_debug_output() noexcept
+    {
+        return debug_output;
+    }
+
+    bool has_direct_state_access() noexcept
+    {
+        return dsa_supported;
+    }
+
+    DebugGroup::DebugGroup(const char* n, const char* f, unsigned int l) noexcept
+    : name(n), file(f), line(l), parent(current_group)
+    {
+        if (debug_supported)
+        {
+            glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+            pushed = true;
+        }
+        current_group = this;
+    }
+
+    DebugGroup::~DebugGroup()
+    {
+        if (pushed)
+        {
+            glPopDebugGroup();
+        }
+        current_group = parent;
+    }
+
+    const DebugGroup* DebugGroup::get_current() noexcept
+    {
+        return current_group;
+    }
+
+    const char* DebugGroup::get_name() const noexcept
+    {
+        return name;
+    }
+
+    const char* DebugGroup::get_file() const noexcept
+    {
+        return file;
+    }
+
+    unsigned int DebugGroup::get_line() const noexcept
+    {
+        return line;
     }
 
 #if !defined(NDEBUG) && defined(__cpp_lib_format) && !defined(_WIN_UWP_)
@@ -104,12 +303,7 @@ namespace glow
 
     void trace(const std::string& file, const unsigned int line, const std::string_view msg) noexcept
     {
-        auto output = std::format("{}({}): {}\n", file, line, msg);
-        #ifdef _WIN32
-        OutputDebugStringA(output.data());
-        #else
-        std::cerr << output;
-        #endif
+        write_output(std::format("{}({}): {}\n", file, line, msg));
     }
 
     void handle_assert(const std::string& file, const unsigned int line, const std::string_view scond) noexcept
@@ -136,6 +330,12 @@ namespace glow
 
     void check_gl_error(const std::string& file, const unsigned int line) noexcept
     {
+        // the debug output callback reports errors without a round trip
+        if (debug_output)
+        {
+            return;
+        }
+
         auto error = glGetError();
         if (error != GL_NO_ERROR)
         {
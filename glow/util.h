@@ -23,6 +23,8 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <functional>
 
 #if defined(WINAPI_FAMILY) && (WINAPI_FAMILY == WINAPI_FAMILY_APP)
 #define _WIN_UWP_
@@ -46,11 +48,91 @@ namespace glow
     //!  @return the last OpenGL error as string
     GLOW_EXPORT const char* gl_error_to_string(unsigned int glerror) noexcept;
 
+    //! Severity of OpenGL debug messages.
+    enum class DebugSeverity
+    {
+        NOTIFICATION,
+        LOW,
+        MEDIUM,
+        HIGH
+    };
+
+    //! Options for the OpenGL debug output.
+    struct DebugOptions
+    {
+        //! Install a KHR_debug message callback.
+        bool enabled = false;
+        //! Ignore messages below this severity, errors are always reported.
+        DebugSeverity severity = DebugSeverity::MEDIUM;
+        //! Report messages from within the call that caused them.
+        bool synchronous = true;
+    };
+
     //! Initialize glow in the current OpenGL context.
     //!
     //! You need to call init in each OpenGL context you intend to use glow
     //! before calling anyhting else.
-    GLOW_EXPORT void init();
+    //!
+    //! If the debug output is enabled and OpenGL 4.3 or KHR_debug is
+    //! available, messages of the driver are written with trace and
+    //! attributed to the innermost debug group. Errors are caught by the
+    //! callback, so GLOW_CHECK_GLERROR no longer polls glGetError. The
+    //! location is only exact with synchronous output.
+    //!
+    //! @param debug the debug output options
+    GLOW_EXPORT void init(const DebugOptions& debug = {});
+
+    //! Check if the debug output callback is installed.
+    GLOW_EXPORT bool is_debug_output() noexcept;
+
+    //! Check if direct state access is used.
+    //!
+    //! With OpenGL 4.5 or ARB_direct_state_access the wrappers create
+    //! and edit objects without binding them.
+    GLOW_EXPORT bool has_direct_state_access() noexcept;
+
+    //! Debug Group
+    //!
+    //! Places the OpenGL calls made during its lifetime in a debug group,
+    //! so that frame captures show them grouped by glow operation. Use
+    //! the GLOW_DEBUG_GROUP macro, which is compiled out in release builds.
+    class GLOW_EXPORT DebugGroup
+    {
+    public:
+        //! Push a debug group.
+        //!
+        //! @param name the name of the group
+        //! @param file the source file of the group
+        //! @param line the source line of the group
+        DebugGroup(const char* name, const char* file, unsigned int line) noexcept;
+
+        //! Pop the debug group.
+        ~DebugGroup();
+
+        //! Get the innermost debug group of this thread.
+        //!
+        //! @return the debug group or nullptr if there is none
+        static const DebugGroup* get_current() noexcept;
+
+        //! Get the name of the group.
+        const char* get_name() const noexcept;
+
+        //! Get the source file of the group.
+        const char* get_file() const noexcept;
+
+        //! Get the source line of the group.
+        unsigned int get_line() const noexcept;
+
+    private:
+        const char*       name   = nullptr;
+        const char*       file   = nullptr;
+        unsigned int      line   = 0u;
+        const DebugGroup* parent = nullptr;
+        bool              pushed = false;
+
+        DebugGroup(const DebugGroup&) = delete;
+        DebugGroup& operator = (const DebugGroup&) = delete;
+    };
 
 #if !defined(NDEBUG) && defined(__cpp_lib_format) && !defined(_WIN_UWP_)
     constexpr std::string basename(const std::string& file) noexcept
@@ -82,6 +164,17 @@ namespace glow
     GLOW_EXPORT void check_gl_error(const std::string& file, const unsigned int line) noexcept;
 #endif
 
+    //! Transparent string hash, allows lookup with std::string_view.
+    struct string_hash
+    {
+        using is_transparent = void;
+
+        size_t operator () (std::string_view value) const noexcept
+        {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
     template<class... Ts> struct overloaded : Ts... { using Ts::operator()...; };
     template<class... Ts> overloaded(Ts...) -> overloaded<Ts...>;
 }
@@ -93,11 +186,22 @@ namespace glow
 #define GLOW_ASSERT(COND)    do { if (!(COND)) { ::glow::handle_assert(::glow::basename(__FILE__), __LINE__, #COND); } } while (false)
 //! Flag this code path as faulty.
 #define GLOW_FAIL(MSG)       ::glow::handle_fail(::glow::basename(__FILE__), __LINE__, MSG)
+#ifndef GLOW_NO_ERROR_POLLING
 //! Check if the OpenGL error is set and notify.
 #define GLOW_CHECK_GLERROR() ::glow::check_gl_error(::glow::basename(__FILE__), __LINE__)
 #else
+#define GLOW_CHECK_GLERROR()
+#endif
+#else
 #define GLOW_TRACE(MSG, ...)
 #define GLOW_ASSERT(COND)
 #define GLOW_FAIL(MSG)
 #define GLOW_CHECK_GLERROR()
 #endif
+
+#ifndef NDEBUG
+//! Place the OpenGL calls of the current block in a debug group.
+#define GLOW_DEBUG_GROUP(NAME) ::glow::DebugGroup glow_debug_group(NAME, __FILE__, __LINE__)
+#else
+#define GLOW_DEBUG_GROUP(NAME)
+#endif